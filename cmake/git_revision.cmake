@@ -0,0 +1,34 @@
+# Writes the revision of the source tree to a header. Runs in script mode on every build (see
+# modules/CMakeLists.txt), so perf records name the commit that was built, not the one of the last configure:
+#   cmake -DSOURCE_DIR=<repo> -DOUTPUT=<header> -P git_revision.cmake
+# The header is only rewritten when the revision changes; a tree with uncommitted changes gets a "-dirty" suffix.
+
+cmake_minimum_required(VERSION 3.25)
+
+set(PPC_GIT_REVISION "unknown")
+find_package(Git QUIET)
+if(GIT_FOUND)
+  execute_process(
+    COMMAND ${GIT_EXECUTABLE} rev-parse --short HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE PPC_GIT_REVISION_OUT
+    OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET
+    RESULT_VARIABLE PPC_GIT_REVISION_RES)
+  if(PPC_GIT_REVISION_RES EQUAL 0 AND PPC_GIT_REVISION_OUT)
+    set(PPC_GIT_REVISION "${PPC_GIT_REVISION_OUT}")
+    execute_process(
+      COMMAND ${GIT_EXECUTABLE} status --porcelain --untracked-files=no
+      WORKING_DIRECTORY ${SOURCE_DIR}
+      OUTPUT_VARIABLE PPC_GIT_STATUS_OUT
+      OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+    if(PPC_GIT_STATUS_OUT)
+      string(APPEND PPC_GIT_REVISION "-dirty")
+    endif()
+  endif()
+endif()
+
+file(
+  CONFIGURE
+  OUTPUT "${OUTPUT}"
+  CONTENT "#pragma once\n\n#define PPC_GIT_REVISION \"@PPC_GIT_REVISION@\"\n"
+  @ONLY)
@@ -27,3 +27,15 @@ if(USE_PERF_TESTS)
   message(STATUS "Enable performance tests")
   add_compile_definitions(USE_PERF_TESTS)
 endif(USE_PERF_TESTS)
+
+option(USE_MPI_PROFILER
+       "Link the PMPI communication profiler into performance tests" OFF)
+if(USE_MPI_PROFILER)
+  message(STATUS "Enable MPI communication profiler")
+endif(USE_MPI_PROFILER)
+
+option(USE_ALLOC_TRACKER
+       "Count heap allocations of performance tests via global operator new/delete" OFF)
+if(USE_ALLOC_TRACKER)
+  message(STATUS "Enable heap allocation tracker")
+endif(USE_ALLOC_TRACKER)
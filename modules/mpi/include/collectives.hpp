@@ -0,0 +1,177 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+#include "mpi/include/distribution.hpp"
+
+namespace ppc::mpi::coll {
+
+// Point-to-point implementations of the common collectives, for any communicator size. Every function is
+// collective over @p comm and has to be called with the same algorithm, count and root on every rank.
+// Reductions assume a commutative operation (all predefined MPI_Ops are); others go to the MPI library.
+
+/// @brief Communication pattern of a collective.
+enum class Algorithm : std::uint8_t {
+  kAuto,               ///< SelectAlgorithm(), or PPC_COLLECTIVE_ALGORITHM if set and supported.
+  kNative,             ///< The MPI library's own implementation.
+  kBinomial,           ///< Binomial tree: bcast, reduce, allreduce (reduce + bcast).
+  kRecursiveDoubling,  ///< Hypercube exchange: allreduce, allgather (power-of-two sizes, Bruck otherwise).
+  kRing,               ///< Ring: bcast (scatter + ring allgather), allreduce, allgather.
+  kRabenseifner,       ///< Recursive-halving reduce-scatter followed by a gather or allgather: reduce, allreduce.
+  kBruck,              ///< Dissemination in ceil(log2 p) steps: allgather, alltoall.
+  kPairwise,           ///< p - 1 pairwise exchanges: alltoall.
+};
+
+enum class Operation : std::uint8_t {
+  kBcast,
+  kReduce,
+  kAllreduce,
+  kAllgather,
+  kAlltoall,
+};
+
+/// @brief Messages up to this size are latency bound: tree/hypercube algorithms for reductions.
+inline constexpr std::size_t kShortMessageBytes = std::size_t{2} << 10;
+/// @brief Broadcasts from this size on (and on at least kBcastMinScatterRanks ranks) scatter + allgather.
+inline constexpr std::size_t kBcastLongMessageBytes = std::size_t{12} << 10;
+inline constexpr int kBcastMinScatterRanks = 8;
+/// @brief Allreduce on non-power-of-two sizes switches from Rabenseifner to the ring from this size on.
+inline constexpr std::size_t kLongMessageBytes = std::size_t{512} << 10;
+/// @brief Allgathers with a smaller result use Bruck / recursive doubling, larger ones the ring.
+inline constexpr std::size_t kAllgatherShortBytes = std::size_t{80} << 10;
+/// @brief Alltoall blocks up to this size use Bruck on at least kAlltoallMinBruckRanks ranks.
+inline constexpr std::size_t kAlltoallShortBlockBytes = 256;
+inline constexpr int kAlltoallMinBruckRanks = 8;
+
+std::string GetStringAlgorithm(Algorithm algorithm);
+
+/// @brief Parses a name returned by GetStringAlgorithm() (case-insensitive).
+/// @throws std::invalid_argument for unknown names.
+Algorithm ParseAlgorithm(const std::string &name);
+
+/// @brief Reads PPC_COLLECTIVE_ALGORITHM (unset: kAuto).
+Algorithm GetAlgorithmOverride();
+
+/// @brief Returns true if @p operation has an implementation of @p algorithm (kAuto and kNative always do).
+bool IsSupported(Operation operation, Algorithm algorithm);
+
+/// @brief Algorithm for a message of @p bytes on @p comm_size ranks.
+/// @param bytes Whole buffer for bcast and the reductions, one rank's block for allgather and alltoall.
+Algorithm SelectAlgorithm(Operation operation, std::size_t bytes, int comm_size);
+
+/// @brief Algorithm actually run for a request: an explicit algorithm is kept (std::invalid_argument if
+/// @p operation does not support it); kAuto takes GetAlgorithmOverride() where supported, SelectAlgorithm() otherwise.
+Algorithm ResolveAlgorithm(Operation operation, Algorithm requested, std::size_t bytes, int comm_size);
+
+namespace detail {
+
+/// Maps a communicator onto its largest power-of-two subset: the first 2 * extra ranks pair up and the even
+/// rank of every pair hands its data to the odd one, which represents both in the power-of-two core.
+struct PowerOfTwoFold {
+  int core_size = 1;
+  int extra = 0;
+
+  /// Rank inside the core, or -1 for ranks that sit the core phase out.
+  [[nodiscard]] int CoreRank(int rank) const {
+    if (rank < 2 * extra) {
+      return rank % 2 == 1 ? rank / 2 : -1;
+    }
+    return rank - extra;
+  }
+  [[nodiscard]] int CommRank(int core_rank) const {
+    return core_rank < extra ? (2 * core_rank) + 1 : core_rank + extra;
+  }
+};
+
+PowerOfTwoFold MakePowerOfTwoFold(int size);
+
+// Type-erased collectives on contiguous buffers of a predefined datatype (or MPI_BYTE).
+// send may be MPI_IN_PLACE where MPI allows it: on the root for Reduce, everywhere for Allreduce and
+// Allgather (the rank's block already sits at rank * count in recv).
+void Bcast(void *data, int count, MPI_Datatype type, int root, MPI_Comm comm, Algorithm algorithm);
+void Reduce(const void *send, void *recv, int count, MPI_Datatype type, MPI_Op op, int root, MPI_Comm comm,
+            Algorithm algorithm);
+void Allreduce(const void *send, void *recv, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+               Algorithm algorithm);
+/// count is the size of one rank's block.
+void Allgather(const void *send, void *recv, int count, MPI_Datatype type, MPI_Comm comm, Algorithm algorithm);
+/// count is the size of the block for one destination.
+void Alltoall(const void *send, void *recv, int count, MPI_Datatype type, MPI_Comm comm, Algorithm algorithm);
+
+/// Converts an element count to the int count of one MPI call, throwing std::invalid_argument if it does not fit.
+int ToCount(std::size_t size, const TypeInfo &type);
+
+int CommSize(MPI_Comm comm);
+
+}  // namespace detail
+
+/// @brief Broadcasts the root's @p data to the same-sized @p data of every rank.
+template <typename T>
+void Bcast(std::span<T> data, int root = 0, MPI_Comm comm = MPI_COMM_WORLD, Algorithm algorithm = Algorithm::kAuto) {
+  const auto type = GetTypeInfo<T>();
+  detail::Bcast(data.data(), detail::ToCount(data.size(), type), type.type, root, comm, algorithm);
+}
+
+/// @brief Element-wise reduction of every rank's @p send into the root's @p recv (ignored elsewhere).
+template <typename T>
+void Reduce(std::span<const T> send, std::span<T> recv, MPI_Op op, int root = 0, MPI_Comm comm = MPI_COMM_WORLD,
+            Algorithm algorithm = Algorithm::kAuto) {
+  static_assert(std::is_arithmetic_v<T>, "Reductions need a predefined MPI datatype");
+  if (mpi::detail::CommRank(comm) == root) {
+    mpi::detail::CheckSize(recv.size(), send.size(), "Reduce: the result buffer is smaller than the input");
+  }
+  const auto type = GetTypeInfo<T>();
+  detail::Reduce(send.data(), recv.data(), detail::ToCount(send.size(), type), type.type, op, root, comm, algorithm);
+}
+
+/// @brief Replaces @p data on every rank by the element-wise reduction over all ranks.
+template <typename T>
+void Allreduce(std::span<T> data, MPI_Op op, MPI_Comm comm = MPI_COMM_WORLD, Algorithm algorithm = Algorithm::kAuto) {
+  static_assert(std::is_arithmetic_v<T>, "Reductions need a predefined MPI datatype");
+  const auto type = GetTypeInfo<T>();
+  detail::Allreduce(MPI_IN_PLACE, data.data(), detail::ToCount(data.size(), type), type.type, op, comm, algorithm);
+}
+
+/// @brief Reduction of a single value over all ranks.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+T Allreduce(T value, MPI_Op op, MPI_Comm comm = MPI_COMM_WORLD, Algorithm algorithm = Algorithm::kAuto) {
+  Allreduce(std::span<T>(&value, 1), op, comm, algorithm);
+  return value;
+}
+
+/// @brief Concatenates the equally sized @p local blocks of all ranks in rank order.
+template <typename T>
+std::vector<T> Allgather(std::span<const T> local, MPI_Comm comm = MPI_COMM_WORLD,
+                         Algorithm algorithm = Algorithm::kAuto) {
+  const auto type = GetTypeInfo<T>();
+  std::vector<T> result(local.size() * static_cast<std::size_t>(detail::CommSize(comm)));
+  detail::Allgather(local.data(), result.data(), detail::ToCount(local.size(), type), type.type, comm, algorithm);
+  return result;
+}
+
+/// @brief Block p of every rank's @p send goes to rank p; block q of the result comes from rank q.
+/// @details @p send holds one equally sized block per rank.
+template <typename T>
+std::vector<T> Alltoall(std::span<const T> send, MPI_Comm comm = MPI_COMM_WORLD,
+                        Algorithm algorithm = Algorithm::kAuto) {
+  const auto size = static_cast<std::size_t>(detail::CommSize(comm));
+  if (send.size() % size != 0) {
+    throw std::invalid_argument("Alltoall: the buffer does not split into one block per rank");
+  }
+  const auto type = GetTypeInfo<T>();
+  std::vector<T> result(send.size());
+  detail::Alltoall(send.data(), result.data(), detail::ToCount(send.size() / size, type), type.type, comm, algorithm);
+  return result;
+}
+
+}  // namespace ppc::mpi::coll
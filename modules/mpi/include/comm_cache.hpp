@@ -0,0 +1,48 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <span>
+
+namespace ppc::mpi {
+
+// Communicators and datatypes that are built once and reused by every later Run() of a task, so collective
+// setup (MPI_Comm_split, MPI_Cart_create) and type commits stay out of the timed loop. The cache owns the
+// returned handles: callers must not free them. Sub-communicators are released together with their parent
+// (attribute caching), everything else at MPI_Finalize or by ClearCommCache().
+//
+// Looking up a communicator is collective over the parent on the first call with a given shape, so all ranks
+// have to ask for the same shapes in the same order; later calls are local.
+
+/// @brief Pairs of ranks differing only in bit @p dim of their rank: the links of hypercube dimension @p dim.
+/// @details Ranks without a partner (non power-of-two sizes) get a communicator of size 1.
+MPI_Comm GetHypercubeComm(MPI_Comm comm, int dim);
+
+/// @brief Cartesian communicator with the given extents and periodicity (no reordering).
+MPI_Comm GetCartComm(MPI_Comm comm, std::span<const int> dims, std::span<const int> periods);
+
+/// @brief Sub-grid of a Cartesian communicator keeping the dimensions with remain_dims[i] != 0 (MPI_Cart_sub).
+MPI_Comm GetCartSubComm(MPI_Comm cart_comm, std::span<const int> remain_dims);
+
+/// @brief Ranks of @p comm on the calling rank's node (MPI_COMM_TYPE_SHARED, ranks keep their order).
+/// @return MPI_COMM_NULL on every rank if @p comm spans several nodes.
+MPI_Comm GetSharedComm(MPI_Comm comm);
+
+/// @brief Duplicate of @p comm (MPI_Comm_dup) for point-to-point collectives.
+/// @details Its messages live in their own context, so they never match the caller's traffic on @p comm, even
+/// receives with MPI_ANY_SOURCE or MPI_ANY_TAG.
+MPI_Comm GetCollectiveComm(MPI_Comm comm);
+
+/// @brief Committed MPI_Type_vector(count, blocklength, stride, base).
+/// @param extent If non-zero, the type is resized (MPI_Type_create_resized) to @p extent base elements, e.g. to
+/// the row length so that consecutive items describe the same columns of consecutive rows.
+MPI_Datatype GetVectorType(int count, int blocklength, int stride, MPI_Datatype base, std::ptrdiff_t extent = 0);
+
+/// @brief Frees all cached handles. Collective over every communicator with cached sub-communicators.
+void ClearCommCache();
+
+/// @brief Number of cached communicators and datatypes (for diagnostics and tests).
+std::size_t GetCommCacheSize();
+
+}  // namespace ppc::mpi
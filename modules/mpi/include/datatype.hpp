@@ -0,0 +1,63 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace ppc::mpi {
+
+/// @brief MPI datatype used to transfer elements of type T.
+/// @details Arithmetic types map to their predefined datatype (units == 1). Any other trivially copyable
+/// type is sent as sizeof(T) MPI_BYTEs, so counts and displacements are multiplied by units.
+struct TypeInfo {
+  MPI_Datatype type = MPI_BYTE;
+  /// @brief Number of @c type items per element.
+  std::size_t units = 1;
+  /// @brief Size of one element in bytes.
+  std::size_t bytes = 1;
+};
+
+template <typename T>
+TypeInfo GetTypeInfo() {
+  static_assert(std::is_trivially_copyable_v<T>, "MPI transfers need trivially copyable elements");
+  using U = std::remove_cv_t<T>;
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  if constexpr (std::is_same_v<U, char>) {
+    type = MPI_CHAR;
+  } else if constexpr (std::is_same_v<U, signed char>) {
+    type = MPI_SIGNED_CHAR;
+  } else if constexpr (std::is_same_v<U, unsigned char>) {
+    type = MPI_UNSIGNED_CHAR;
+  } else if constexpr (std::is_same_v<U, short>) {
+    type = MPI_SHORT;
+  } else if constexpr (std::is_same_v<U, unsigned short>) {
+    type = MPI_UNSIGNED_SHORT;
+  } else if constexpr (std::is_same_v<U, int>) {
+    type = MPI_INT;
+  } else if constexpr (std::is_same_v<U, unsigned int>) {
+    type = MPI_UNSIGNED;
+  } else if constexpr (std::is_same_v<U, long>) {
+    type = MPI_LONG;
+  } else if constexpr (std::is_same_v<U, unsigned long>) {
+    type = MPI_UNSIGNED_LONG;
+  } else if constexpr (std::is_same_v<U, long long>) {
+    type = MPI_LONG_LONG;
+  } else if constexpr (std::is_same_v<U, unsigned long long>) {
+    type = MPI_UNSIGNED_LONG_LONG;
+  } else if constexpr (std::is_same_v<U, float>) {
+    type = MPI_FLOAT;
+  } else if constexpr (std::is_same_v<U, double>) {
+    type = MPI_DOUBLE;
+  } else if constexpr (std::is_same_v<U, long double>) {
+    type = MPI_LONG_DOUBLE;
+  } else if constexpr (std::is_same_v<U, bool>) {
+    type = MPI_CXX_BOOL;
+  }
+  if (type == MPI_DATATYPE_NULL) {
+    return {.type = MPI_BYTE, .units = sizeof(T), .bytes = sizeof(T)};
+  }
+  return {.type = type, .units = 1, .bytes = sizeof(T)};
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+
+namespace ppc::mpi {
+
+/// @brief Largest count a single MPI-3 call accepts; bigger transfers are split into segments of this size.
+inline constexpr std::size_t kMaxMessageCount = INT_MAX;
+
+/// @brief Element counts and displacements of the parts of a buffer, one entry per rank.
+/// @details 64-bit counterpart of the sendcounts/displs arrays of MPI_Scatterv. Collectives taking a
+/// Distribution must be called with the same one on every rank of the communicator.
+struct Distribution {
+  std::vector<std::size_t> counts;
+  std::vector<std::size_t> displs;
+
+  [[nodiscard]] int Parts() const {
+    return static_cast<int>(counts.size());
+  }
+
+  /// @brief Number of elements covered by all parts.
+  [[nodiscard]] std::size_t Total() const {
+    std::size_t total = 0;
+    for (std::size_t part = 0; part < counts.size(); part++) {
+      total = std::max(total, displs[part] + counts[part]);
+    }
+    return total;
+  }
+
+  /// @brief Returns true if every count and displacement, scaled by @p units, fits into an int.
+  [[nodiscard]] bool FitsInt(std::size_t units = 1) const;
+};
+
+/// @brief Builds a distribution of back-to-back parts with the given counts.
+Distribution MakeDistribution(std::vector<std::size_t> counts);
+
+/// @brief Splits @p items items of @p item_size elements each (e.g. matrix rows) into contiguous blocks.
+/// @details The first items % parts blocks get one extra item, the usual MPI_Scatterv split.
+Distribution BlockDistribution(std::size_t items, int parts, std::size_t item_size = 1);
+
+/// @brief Contiguous blocks; part p owns [displs[p], displs[p] + counts[p]).
+class BlockPartition {
+ public:
+  BlockPartition(std::size_t size, int parts);
+
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+  [[nodiscard]] int Parts() const {
+    return parts_;
+  }
+  /// @brief Returns the part owning global element @p index.
+  [[nodiscard]] int Owner(std::size_t index) const;
+  [[nodiscard]] std::size_t LocalSize(int part) const;
+  /// @brief Returns the position of global element @p index inside its owner's part.
+  [[nodiscard]] std::size_t ToLocal(std::size_t index) const;
+  /// @brief Returns the global index of element @p local of @p part.
+  [[nodiscard]] std::size_t ToGlobal(int part, std::size_t local) const;
+  /// @brief Layout of the parts in the global buffer.
+  [[nodiscard]] const Distribution &GetDistribution() const {
+    return distribution_;
+  }
+
+ private:
+  std::size_t size_ = 0;
+  int parts_ = 1;
+  Distribution distribution_;
+};
+
+/// @brief Blocks of @p block_size elements dealt round-robin: block b belongs to part b % parts.
+/// @details A block size of 1 is the cyclic distribution, which balances work whose cost grows with the
+/// index (triangular loops, elimination). The parts are not contiguous in the global buffer; collectives
+/// pack them, and GetDistribution() describes the packed (owner-major) buffer.
+class BlockCyclicPartition {
+ public:
+  BlockCyclicPartition(std::size_t size, int parts, std::size_t block_size);
+
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+  [[nodiscard]] int Parts() const {
+    return parts_;
+  }
+  [[nodiscard]] std::size_t BlockSize() const {
+    return block_size_;
+  }
+  [[nodiscard]] int Owner(std::size_t index) const;
+  [[nodiscard]] std::size_t LocalSize(int part) const;
+  [[nodiscard]] std::size_t ToLocal(std::size_t index) const;
+  [[nodiscard]] std::size_t ToGlobal(int part, std::size_t local) const;
+  [[nodiscard]] const Distribution &GetDistribution() const {
+    return distribution_;
+  }
+
+ private:
+  std::size_t size_ = 0;
+  int parts_ = 1;
+  std::size_t block_size_ = 1;
+  Distribution distribution_;
+};
+
+/// @brief Element i belongs to part i % parts.
+inline BlockCyclicPartition CyclicPartition(std::size_t size, int parts) {
+  return {size, parts, 1};
+}
+
+/// @brief Common interface of the partitioners.
+template <typename P>
+concept Partition = requires(const P &partition, std::size_t index, int part) {
+  { partition.Size() } -> std::convertible_to<std::size_t>;
+  { partition.Parts() } -> std::convertible_to<int>;
+  { partition.Owner(index) } -> std::convertible_to<int>;
+  { partition.LocalSize(part) } -> std::convertible_to<std::size_t>;
+  { partition.ToLocal(index) } -> std::convertible_to<std::size_t>;
+  { partition.ToGlobal(part, index) } -> std::convertible_to<std::size_t>;
+  { partition.GetDistribution() } -> std::convertible_to<const Distribution &>;
+};
+
+/// @brief Copies @p data (global order) into @p packed, grouped by owner as described by GetDistribution().
+template <typename T>
+void Pack(const BlockCyclicPartition &partition, std::span<const T> data, std::span<T> packed) {
+  const auto &dist = partition.GetDistribution();
+  for (std::size_t begin = 0; begin < partition.Size(); begin += partition.BlockSize()) {
+    const auto len = std::min(partition.BlockSize(), partition.Size() - begin);
+    const auto owner = static_cast<std::size_t>(partition.Owner(begin));
+    std::copy_n(data.begin() + static_cast<std::ptrdiff_t>(begin), len,
+                packed.begin() + static_cast<std::ptrdiff_t>(dist.displs[owner] + partition.ToLocal(begin)));
+  }
+}
+
+/// @brief Inverse of Pack().
+template <typename T>
+void Unpack(const BlockCyclicPartition &partition, std::span<const T> packed, std::span<T> data) {
+  const auto &dist = partition.GetDistribution();
+  for (std::size_t begin = 0; begin < partition.Size(); begin += partition.BlockSize()) {
+    const auto len = std::min(partition.BlockSize(), partition.Size() - begin);
+    const auto owner = static_cast<std::size_t>(partition.Owner(begin));
+    std::copy_n(packed.begin() + static_cast<std::ptrdiff_t>(dist.displs[owner] + partition.ToLocal(begin)), len,
+                data.begin() + static_cast<std::ptrdiff_t>(begin));
+  }
+}
+
+/// @brief Broadcasts a size (e.g. of the root's input) as a 64-bit value.
+std::size_t BroadcastSize(std::size_t size, int root = 0, MPI_Comm comm = MPI_COMM_WORLD);
+
+namespace detail {
+
+// Type-erased collectives. Counts that fit into an int go through the MPI_*v collective; larger ones are sent
+// as point-to-point segments (scatter/gather) or broadcast segments (allgather) of at most max_count items.
+// With in_place set the root's (scatter/gather) or every rank's (allgather) own part already is in place.
+void Scatterv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, int root, MPI_Comm comm,
+              bool in_place, std::size_t max_count = kMaxMessageCount);
+void Gatherv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, int root, MPI_Comm comm,
+             bool in_place, std::size_t max_count = kMaxMessageCount);
+
+// Posts the point-to-point segments of Scatterv() and appends their requests; the caller waits for them.
+void StartSegmentedScatterv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, int root,
+                            MPI_Comm comm, bool in_place, std::size_t max_count, std::vector<MPI_Request> &requests);
+void Allgatherv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, MPI_Comm comm,
+                bool in_place, std::size_t max_count = kMaxMessageCount);
+
+int CommRank(MPI_Comm comm);
+
+/// Throws std::invalid_argument unless the distribution has one part per rank of comm.
+void CheckCommSize(const Distribution &dist, MPI_Comm comm);
+
+inline void CheckSize(std::size_t actual, std::size_t expected, const char *what) {
+  if (actual < expected) {
+    throw std::invalid_argument(what);
+  }
+}
+
+}  // namespace detail
+
+/// @brief Sends part p of the root's @p data to rank p and returns the calling rank's part.
+/// @param data Whole buffer on the root; ignored elsewhere.
+template <typename T>
+std::vector<T> Scatter(std::span<const T> data, const Distribution &dist, int root = 0,
+                       MPI_Comm comm = MPI_COMM_WORLD) {
+  const int rank = detail::CommRank(comm);
+  if (rank == root) {
+    detail::CheckSize(data.size(), dist.Total(), "Scatter: the root buffer is smaller than the distribution");
+  }
+  std::vector<T> local(dist.counts.at(static_cast<std::size_t>(rank)));
+  detail::Scatterv(data.data(), local.data(), dist, GetTypeInfo<T>(), root, comm, false);
+  return local;
+}
+
+/// @brief Scatter into a full-size buffer held by every rank: rank p receives its part at displs[p].
+/// @details Avoids a separate local buffer and the root's self-copy.
+template <typename T>
+void ScatterInPlace(std::span<T> data, const Distribution &dist, int root = 0, MPI_Comm comm = MPI_COMM_WORLD) {
+  const auto rank = static_cast<std::size_t>(detail::CommRank(comm));
+  detail::CheckSize(data.size(), dist.displs.at(rank) + dist.counts.at(rank),
+                    "ScatterInPlace: the buffer does not cover the rank's part");
+  detail::Scatterv(data.data(), data.data() + dist.displs[rank], dist, GetTypeInfo<T>(), root, comm, true);
+}
+
+/// @brief Collects every rank's @p local part on the root; returns the whole buffer on the root, empty elsewhere.
+template <typename T>
+std::vector<T> Gather(std::span<const T> local, const Distribution &dist, int root = 0,
+                      MPI_Comm comm = MPI_COMM_WORLD) {
+  const int rank = detail::CommRank(comm);
+  detail::CheckSize(local.size(), dist.counts.at(static_cast<std::size_t>(rank)),
+                    "Gather: the local part is smaller than the distribution");
+  std::vector<T> result(rank == root ? dist.Total() : 0);
+  detail::Gatherv(local.data(), result.data(), dist, GetTypeInfo<T>(), root, comm, false);
+  return result;
+}
+
+/// @brief Gather within a full-size buffer: every rank's part sits at displs[rank]; the root ends up with all.
+template <typename T>
+void GatherInPlace(std::span<T> data, const Distribution &dist, int root = 0, MPI_Comm comm = MPI_COMM_WORLD) {
+  const int rank = detail::CommRank(comm);
+  const auto part = static_cast<std::size_t>(rank);
+  detail::CheckSize(data.size(), rank == root ? dist.Total() : dist.displs.at(part) + dist.counts.at(part),
+                    "GatherInPlace: the buffer does not cover the distribution");
+  detail::Gatherv(data.data() + dist.displs[part], data.data(), dist, GetTypeInfo<T>(), root, comm, true);
+}
+
+/// @brief Collects every rank's @p local part on all ranks.
+template <typename T>
+std::vector<T> Allgather(std::span<const T> local, const Distribution &dist, MPI_Comm comm = MPI_COMM_WORLD) {
+  const auto rank = static_cast<std::size_t>(detail::CommRank(comm));
+  detail::CheckSize(local.size(), dist.counts.at(rank), "Allgather: the local part is smaller than the distribution");
+  std::vector<T> result(dist.Total());
+  detail::Allgatherv(local.data(), result.data(), dist, GetTypeInfo<T>(), comm, false);
+  return result;
+}
+
+/// @brief Allgather within a full-size buffer whose part displs[rank] already holds the rank's data.
+template <typename T>
+void AllgatherInPlace(std::span<T> data, const Distribution &dist, MPI_Comm comm = MPI_COMM_WORLD) {
+  detail::CheckSize(data.size(), dist.Total(), "AllgatherInPlace: the buffer does not cover the distribution");
+  detail::Allgatherv(nullptr, data.data(), dist, GetTypeInfo<T>(), comm, true);
+}
+
+/// @brief Scatters the root's @p data (global order) by @p partition and returns the rank's elements in local order.
+template <typename T, Partition P>
+std::vector<T> Scatter(const P &partition, std::span<const T> data, int root = 0, MPI_Comm comm = MPI_COMM_WORLD) {
+  if constexpr (std::same_as<P, BlockPartition>) {
+    return Scatter(data, partition.GetDistribution(), root, comm);
+  } else {
+    std::vector<T> packed;
+    if (detail::CommRank(comm) == root) {
+      detail::CheckSize(data.size(), partition.Size(), "Scatter: the root buffer is smaller than the partition");
+      packed.resize(partition.Size());
+      Pack(partition, data, std::span<T>(packed));
+    }
+    return Scatter(std::span<const T>(packed), partition.GetDistribution(), root, comm);
+  }
+}
+
+/// @brief Reassembles every rank's @p local elements into global order on all ranks.
+template <typename T, Partition P>
+std::vector<T> Allgather(const P &partition, std::span<const T> local, MPI_Comm comm = MPI_COMM_WORLD) {
+  if constexpr (std::same_as<P, BlockPartition>) {
+    return Allgather(local, partition.GetDistribution(), comm);
+  } else {
+    const auto packed = Allgather(local, partition.GetDistribution(), comm);
+    std::vector<T> result(partition.Size());
+    Unpack(partition, std::span<const T>(packed), std::span<T>(result));
+    return result;
+  }
+}
+
+/// @brief Reassembles every rank's @p local elements into global order on the root (empty elsewhere).
+template <typename T, Partition P>
+std::vector<T> Gather(const P &partition, std::span<const T> local, int root = 0, MPI_Comm comm = MPI_COMM_WORLD) {
+  if constexpr (std::same_as<P, BlockPartition>) {
+    return Gather(local, partition.GetDistribution(), root, comm);
+  } else {
+    const auto packed = Gather(local, partition.GetDistribution(), root, comm);
+    if (packed.empty()) {
+      return {};
+    }
+    std::vector<T> result(partition.Size());
+    Unpack(partition, std::span<const T>(packed), std::span<T>(result));
+    return result;
+  }
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+#include "mpi/include/distribution.hpp"
+
+namespace ppc::mpi {
+
+/// @brief Smallest chunk (per rank) worth a separate collective; below it latency outweighs the overlap.
+inline constexpr std::size_t kPipelineMinChunkBytes = std::size_t{256} << 10;
+/// @brief Upper bound of the automatically chosen number of chunks.
+inline constexpr std::size_t kPipelineMaxChunks = 16;
+
+/// @brief Number of chunks for a pipeline whose largest per-rank part has @p part_bytes bytes.
+/// @details One chunk per kPipelineMinChunkBytes, between 1 and kPipelineMaxChunks.
+std::size_t AutoPipelineChunks(std::size_t part_bytes);
+
+/// @brief Reads PPC_PIPELINE_CHUNKS (0 or unset: automatic).
+std::size_t GetPipelineChunksOverride();
+
+/// @brief Number of chunks used for @p dist: the override if set, AutoPipelineChunks() otherwise; always
+/// enough to keep every chunk below kMaxMessageCount items.
+std::size_t GetPipelineChunks(const Distribution &dist, const TypeInfo &type);
+
+/// @brief Chunk @p chunk of @p chunks: every part of @p dist split like BlockDistribution().
+Distribution ChunkDistribution(const Distribution &dist, std::size_t chunk, std::size_t chunks);
+
+namespace detail {
+
+/// A chunk scatter in flight; the count arrays have to stay alive until it completes.
+struct PendingScatter {
+  std::vector<int> counts;
+  std::vector<int> displs;
+  std::vector<MPI_Request> requests;
+
+  void Wait() {
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+  }
+  void Test() {
+    int done = 0;
+    MPI_Testall(static_cast<int>(requests.size()), requests.data(), &done, MPI_STATUSES_IGNORE);
+  }
+};
+
+/// Starts the scatter of one chunk. Displacements are taken from the chunk's lowest one, so a chunk deep
+/// inside a buffer larger than INT_MAX items still goes as one MPI_Iscatterv; parts that lie further apart
+/// than that are sent point to point, also without blocking.
+void StartScatterv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, int root,
+                   MPI_Comm comm, PendingScatter &pending);
+
+}  // namespace detail
+
+/// @brief Scatters the root's @p data and folds it chunk by chunk while the next chunk is in flight, then
+/// combines the per-rank results with MPI_Allreduce.
+/// @details Every rank's part is split into @p chunks pieces (0: GetPipelineChunks()). The transfer of chunk k+1
+/// is started before chunk k is folded, and the fold polls it in between so MPI libraries without an async
+/// progress thread advance it too. Only two chunk buffers are allocated per rank instead of the whole part.
+/// @param fold Acc(Acc, std::span<const T>); may be called on any contiguous piece of the part, so it must be a
+/// reduction (e.g. sum, min, max) and agree with @p op.
+/// @return The reduced value on every rank.
+template <typename T, typename Acc, typename Fold>
+Acc PipelinedScatterReduce(std::span<const T> data, const Distribution &dist, Acc init, Fold &&fold, MPI_Op op,
+                           int root = 0, MPI_Comm comm = MPI_COMM_WORLD, std::size_t chunks = 0) {
+  static_assert(std::is_arithmetic_v<Acc>, "The reduced value must map to a predefined MPI datatype");
+  const auto type = GetTypeInfo<T>();
+  const int rank = detail::CommRank(comm);
+  const auto own = static_cast<std::size_t>(rank);
+  if (rank == root) {
+    detail::CheckSize(data.size(), dist.Total(), "PipelinedScatterReduce: the root buffer is smaller than the data");
+  }
+  if (chunks == 0) {
+    chunks = GetPipelineChunks(dist, type);
+  }
+
+  const std::size_t max_chunk = (dist.counts.at(own) + chunks - 1) / chunks;
+  std::array<std::vector<T>, 2> buffers = {std::vector<T>(max_chunk), std::vector<T>(max_chunk)};
+  std::array<std::size_t, 2> sizes = {0, 0};
+  std::array<detail::PendingScatter, 2> pending;
+  const auto start = [&](std::size_t chunk) {
+    const auto slot = chunk % 2;
+    const auto chunk_dist = ChunkDistribution(dist, chunk, chunks);
+    sizes[slot] = chunk_dist.counts[own];
+    detail::StartScatterv(data.data(), buffers[slot].data(), chunk_dist, type, root, comm, pending[slot]);
+  };
+
+  constexpr std::size_t kPolls = 4;
+  Acc local = init;
+  start(0);
+  for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+    const auto slot = chunk % 2;
+    if (chunk + 1 < chunks) {
+      start(chunk + 1);
+    }
+    pending[slot].Wait();
+    const std::span<const T> piece(buffers[slot].data(), sizes[slot]);
+    const std::size_t step = std::max<std::size_t>((piece.size() + kPolls - 1) / kPolls, 1);
+    for (std::size_t begin = 0; begin < piece.size(); begin += step) {
+      local = fold(local, piece.subspan(begin, std::min(step, piece.size() - begin)));
+      pending[1 - slot].Test();
+    }
+  }
+
+  Acc global = init;
+  MPI_Allreduce(&local, &global, 1, GetTypeInfo<Acc>().type, op, comm);
+  return global;
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mpi/include/distribution.hpp"
+
+namespace ppc::mpi {
+
+/// @brief Returns true if all ranks of @p comm share one node (MPI_COMM_TYPE_SHARED). Collective.
+bool IsSharedMemoryComm(MPI_Comm comm);
+
+/// @brief Node-shared memory allocated by one rank with MPI_Win_allocate_shared and readable by all.
+/// @details Construction and destruction are collective over the communicator, so every rank has to release
+/// its reference at the same point of the program (e.g. at the end of the same scope). Windows run on the cached
+/// node communicator, so a window from Create() has to be released before ClearCommCache().
+class SharedWindow {
+ public:
+  /// @brief Allocates @p bytes on @p owner; the other ranks map the owner's segment. Collective over @p comm.
+  /// @return nullptr if the ranks of @p comm do not share a node.
+  static std::shared_ptr<SharedWindow> Create(MPI_Comm comm, int owner, std::size_t bytes);
+
+  /// @brief Window of at least @p bytes on @p owner that is kept for later calls. Collective over @p comm.
+  /// @details Every rank passes the same @p bytes. A call that needs more than the kept window reallocates it,
+  /// which invalidates pointers into the old one. The window is freed together with the node communicator
+  /// (see GetSharedComm()), i.e. with @p comm, by ClearCommCache() or at MPI_Finalize.
+  /// @return nullptr if the ranks of @p comm do not share a node.
+  static SharedWindow *GetCached(MPI_Comm comm, int owner, std::size_t bytes);
+
+  SharedWindow(const SharedWindow &) = delete;
+  SharedWindow &operator=(const SharedWindow &) = delete;
+  ~SharedWindow();
+
+  /// @brief Start of the owner's segment in the calling process's address space.
+  [[nodiscard]] std::byte *Data() const {
+    return data_;
+  }
+
+  /// @brief Bytes allocated on the owner.
+  [[nodiscard]] std::size_t Size() const {
+    return bytes_;
+  }
+
+  /// @brief Waits until every rank is done reading the current contents. Collective; call before the owner
+  /// overwrites a window that has been published before.
+  void Reclaim();
+
+  /// @brief Makes the owner's writes visible to all ranks. Collective; call after the owner has written.
+  void Publish();
+
+ private:
+  SharedWindow() = default;
+  static std::unique_ptr<SharedWindow> Allocate(MPI_Comm node_comm, int owner, std::size_t bytes);
+
+  // The node communicator belongs to the communicator cache
+  MPI_Comm comm_ = MPI_COMM_NULL;
+  MPI_Win win_ = MPI_WIN_NULL;
+  std::byte *data_ = nullptr;
+  std::size_t bytes_ = 0;
+};
+
+/// @brief The calling rank's part of a scattered buffer.
+/// @details Either points into the root's input (on the root) or into a shared window, or owns a received copy.
+template <typename T>
+class LocalPart {
+ public:
+  LocalPart() = default;
+
+  /// @brief Owns a received copy.
+  explicit LocalPart(std::vector<T> data) : owned_(std::move(data)) {}
+
+  /// @brief Views memory kept alive by the caller or the window cache.
+  explicit LocalPart(std::span<const T> view) : view_(view), is_view_(true) {}
+
+  [[nodiscard]] std::span<const T> Get() const {
+    return is_view_ ? view_ : std::span<const T>(owned_);
+  }
+
+  /// @brief Returns true if the part was not copied through MPI messages.
+  [[nodiscard]] bool IsShared() const {
+    return is_view_;
+  }
+
+ private:
+  std::vector<T> owned_;
+  std::span<const T> view_;
+  bool is_view_ = false;
+};
+
+/// @brief Scatter that avoids messages when all ranks share a node.
+/// @details On a single node the root packs the other ranks' parts, in rank order, into a cached SharedWindow and
+/// every rank reads its slice in place; the root views its own slice of @p data directly, so @p data has to
+/// outlive the result there. The window is reused by the next ScatterView() with the same @p comm and @p root, so
+/// a shared part is valid until then or until ClearCommCache() (which the perf harness calls after every test):
+/// copy it out if it has to live longer. Across nodes this falls back to Scatter().
+template <typename T>
+LocalPart<T> ScatterView(std::span<const T> data, const Distribution &dist, int root = 0,
+                         MPI_Comm comm = MPI_COMM_WORLD) {
+  static_assert(std::is_trivially_copyable_v<T>, "ScatterView needs trivially copyable elements");
+  detail::CheckCommSize(dist, comm);
+  const int rank = detail::CommRank(comm);
+  const auto own = static_cast<std::size_t>(rank);
+  if (rank == root) {
+    detail::CheckSize(data.size(), dist.Total(), "ScatterView: the root buffer is smaller than the distribution");
+  }
+  if (dist.Parts() == 1) {
+    return LocalPart<T>(data.subspan(dist.displs[0], dist.counts[0]));
+  }
+
+  // Offsets of the non-root parts in the window; the root's part never goes through it
+  const auto root_part = static_cast<std::size_t>(root);
+  std::vector<std::size_t> offsets(dist.counts.size());
+  std::size_t shared_items = 0;
+  for (std::size_t part = 0; part < dist.counts.size(); part++) {
+    offsets[part] = shared_items;
+    if (part != root_part) {
+      shared_items += dist.counts[part];
+    }
+  }
+  auto *window = SharedWindow::GetCached(comm, root, shared_items * sizeof(T));
+  if (window == nullptr) {
+    return LocalPart<T>(Scatter(data, dist, root, comm));
+  }
+  auto *shared = reinterpret_cast<T *>(window->Data());
+  window->Reclaim();
+  if (rank == root) {
+    for (std::size_t part = 0; part < dist.counts.size(); part++) {
+      if (part != own && dist.counts[part] != 0) {
+        std::memcpy(shared + offsets[part], data.data() + dist.displs[part], dist.counts[part] * sizeof(T));
+      }
+    }
+  }
+  window->Publish();
+  if (rank == root) {
+    return LocalPart<T>(data.subspan(dist.displs[own], dist.counts[own]));
+  }
+  return LocalPart<T>(std::span<const T>(shared + offsets[own], dist.counts[own]));
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,664 @@
+#include "mpi/include/collectives.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <libenvpp/detail/get.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mpi/include/comm_cache.hpp"
+#include "mpi/include/datatype.hpp"
+#include "mpi/include/distribution.hpp"
+
+namespace ppc::mpi::coll {
+
+namespace {
+
+constexpr int kCollectiveTag = 0x5ec;
+
+constexpr std::array kAlgorithms = {
+    Algorithm::kAuto, Algorithm::kNative,       Algorithm::kBinomial, Algorithm::kRecursiveDoubling,
+    Algorithm::kRing, Algorithm::kRabenseifner, Algorithm::kBruck,    Algorithm::kPairwise,
+};
+
+bool IsPowerOfTwo(int value) {
+  return value > 0 && (value & (value - 1)) == 0;
+}
+
+/// Communicator, datatype and the point-to-point calls the algorithms are built from. The communicator is the
+/// cached duplicate of the caller's, so the fixed tag cannot match the caller's own messages.
+struct Context {
+  MPI_Comm comm = MPI_COMM_NULL;
+  int rank = 0;
+  int size = 1;
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  std::size_t extent = 0;
+
+  [[nodiscard]] std::size_t Bytes(std::size_t items) const {
+    return items * extent;
+  }
+  [[nodiscard]] std::byte *At(void *base, std::size_t index) const {
+    return static_cast<std::byte *>(base) + Bytes(index);
+  }
+  [[nodiscard]] const std::byte *At(const void *base, std::size_t index) const {
+    return static_cast<const std::byte *>(base) + Bytes(index);
+  }
+  void Send(const void *data, int count, int dest) const {
+    MPI_Send(data, count, type, dest, kCollectiveTag, comm);
+  }
+  void Recv(void *data, int count, int source) const {
+    MPI_Recv(data, count, type, source, kCollectiveTag, comm, MPI_STATUS_IGNORE);
+  }
+  void Exchange(const void *send, int send_count, int dest, void *recv, int recv_count, int source) const {
+    MPI_Sendrecv(send, send_count, type, dest, kCollectiveTag, recv, recv_count, type, source, kCollectiveTag, comm,
+                 MPI_STATUS_IGNORE);
+  }
+  /// inout = in op inout.
+  void ReduceLocal(const void *in, void *inout, int count, MPI_Op op) const {
+    if (count > 0) {
+      MPI_Reduce_local(in, inout, count, type, op);
+    }
+  }
+};
+
+Context MakeContext(MPI_Comm comm, MPI_Datatype type) {
+  Context ctx;
+  ctx.comm = GetCollectiveComm(comm);
+  ctx.type = type;
+  MPI_Comm_rank(comm, &ctx.rank);
+  MPI_Comm_size(comm, &ctx.size);
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(type, &lower_bound, &extent);
+  ctx.extent = static_cast<std::size_t>(extent);
+  return ctx;
+}
+
+/// Items covered by blocks [first, last) of a back-to-back distribution.
+struct Range {
+  std::size_t offset = 0;
+  int count = 0;
+};
+
+Range BlockRange(const Distribution &blocks, int first, int last) {
+  if (first >= last) {
+    return {};
+  }
+  const auto begin = blocks.displs[static_cast<std::size_t>(first)];
+  const auto back = static_cast<std::size_t>(last - 1);
+  const auto end = blocks.displs[back] + blocks.counts[back];
+  return {.offset = begin, .count = static_cast<int>(end - begin)};
+}
+
+/// Buffer the reduction accumulates into: recv if the rank has one, a copy of send otherwise.
+std::byte *PrepareAccumulator(const Context &ctx, const void *send, void *recv, int count, bool has_recv,
+                              std::vector<std::byte> &storage) {
+  if (send == MPI_IN_PLACE) {
+    return static_cast<std::byte *>(recv);
+  }
+  if (has_recv) {
+    std::memcpy(recv, send, ctx.Bytes(count));
+    return static_cast<std::byte *>(recv);
+  }
+  const auto *begin = static_cast<const std::byte *>(send);
+  storage.assign(begin, begin + ctx.Bytes(count));
+  return storage.data();
+}
+
+void BcastBinomial(const Context &ctx, void *data, int count, int root) {
+  const int vrank = (ctx.rank - root + ctx.size) % ctx.size;
+  int mask = 1;
+  while (mask < ctx.size) {
+    if ((vrank & mask) != 0) {
+      ctx.Recv(data, count, (vrank - mask + root) % ctx.size);
+      break;
+    }
+    mask <<= 1;
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    if (vrank + mask < ctx.size) {
+      ctx.Send(data, count, (vrank + mask + root) % ctx.size);
+    }
+  }
+}
+
+/// Ring allgather of blocks: the rank at ring position v = (rank - shift) mod size starts with block v and
+/// receives the others from its left neighbour, one per step.
+void RingAllgather(const Context &ctx, void *data, const Distribution &blocks, int shift) {
+  const int position = (ctx.rank - shift + ctx.size) % ctx.size;
+  const int right = (ctx.rank + 1) % ctx.size;
+  const int left = (ctx.rank - 1 + ctx.size) % ctx.size;
+  for (int step = 0; step + 1 < ctx.size; step++) {
+    const int send_block = (position - step + ctx.size) % ctx.size;
+    const int recv_block = (position - step - 1 + (2 * ctx.size)) % ctx.size;
+    const auto send = BlockRange(blocks, send_block, send_block + 1);
+    const auto recv = BlockRange(blocks, recv_block, recv_block + 1);
+    ctx.Exchange(ctx.At(data, send.offset), send.count, right, ctx.At(data, recv.offset), recv.count, left);
+  }
+}
+
+/// Van de Geijn broadcast: binomial scatter of size blocks, then a ring allgather. Moves about 2n bytes per
+/// rank instead of n log p, at the price of p - 1 extra latencies.
+void BcastScatterRing(const Context &ctx, void *data, int count, int root) {
+  const auto blocks = BlockDistribution(static_cast<std::size_t>(count), ctx.size);
+  const int vrank = (ctx.rank - root + ctx.size) % ctx.size;
+  // The subtree of vrank v in the binomial tree covers the blocks [v, v + lowest set bit of v)
+  int mask = 1;
+  while (mask < ctx.size) {
+    if ((vrank & mask) != 0) {
+      const auto range = BlockRange(blocks, vrank, std::min(vrank + mask, ctx.size));
+      ctx.Recv(ctx.At(data, range.offset), range.count, (vrank - mask + root) % ctx.size);
+      break;
+    }
+    mask <<= 1;
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    if (vrank + mask < ctx.size) {
+      const auto range = BlockRange(blocks, vrank + mask, std::min(vrank + (2 * mask), ctx.size));
+      ctx.Send(ctx.At(data, range.offset), range.count, (vrank + mask + root) % ctx.size);
+    }
+  }
+  RingAllgather(ctx, data, blocks, root);
+}
+
+void ReduceBinomial(const Context &ctx, std::byte *acc, int count, MPI_Op op, int root) {
+  std::vector<std::byte> tmp(ctx.Bytes(count));
+  const int vrank = (ctx.rank - root + ctx.size) % ctx.size;
+  for (int mask = 1; mask < ctx.size; mask <<= 1) {
+    if ((vrank & mask) != 0) {
+      ctx.Send(acc, count, (vrank - mask + root) % ctx.size);
+      break;
+    }
+    if (vrank + mask < ctx.size) {
+      ctx.Recv(tmp.data(), count, (vrank + mask + root) % ctx.size);
+      ctx.ReduceLocal(tmp.data(), acc, count, op);
+    }
+  }
+}
+
+/// First half of the non-power-of-two fold: the even rank of every extra pair hands its data to the odd one.
+void FoldIn(const Context &ctx, const detail::PowerOfTwoFold &fold, std::byte *acc, std::byte *tmp, int count,
+            MPI_Op op) {
+  if (ctx.rank >= 2 * fold.extra) {
+    return;
+  }
+  if (ctx.rank % 2 == 0) {
+    ctx.Send(acc, count, ctx.rank + 1);
+  } else {
+    ctx.Recv(tmp, count, ctx.rank - 1);
+    ctx.ReduceLocal(tmp, acc, count, op);
+  }
+}
+
+/// Second half of the fold: the odd rank returns the result.
+void FoldOut(const Context &ctx, const detail::PowerOfTwoFold &fold, std::byte *acc, int count) {
+  if (ctx.rank >= 2 * fold.extra) {
+    return;
+  }
+  if (ctx.rank % 2 == 1) {
+    ctx.Send(acc, count, ctx.rank - 1);
+  } else {
+    ctx.Recv(acc, count, ctx.rank + 1);
+  }
+}
+
+/// Recursive halving over the power-of-two core: every step exchanges half of the remaining blocks with the
+/// partner across one hypercube dimension. Leaves block core_rank of @p acc reduced over all ranks.
+void ReduceScatterHalving(const Context &ctx, const detail::PowerOfTwoFold &fold, int core_rank, std::byte *acc,
+                          std::byte *tmp, const Distribution &blocks, MPI_Op op) {
+  int low = 0;
+  int high = fold.core_size;
+  for (int mask = fold.core_size / 2; mask > 0; mask >>= 1) {
+    const int partner = fold.CommRank(core_rank ^ mask);
+    const int middle = low + mask;
+    const bool upper = (core_rank & mask) != 0;
+    const auto keep = upper ? BlockRange(blocks, middle, high) : BlockRange(blocks, low, middle);
+    const auto give = upper ? BlockRange(blocks, low, middle) : BlockRange(blocks, middle, high);
+    ctx.Exchange(ctx.At(acc, give.offset), give.count, partner, ctx.At(tmp, keep.offset), keep.count, partner);
+    ctx.ReduceLocal(ctx.At(tmp, keep.offset), ctx.At(acc, keep.offset), keep.count, op);
+    if (upper) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+}
+
+/// Recursive doubling over the power-of-two core: core rank c starts with block c and doubles its range of
+/// blocks with every step.
+void AllgatherDoubling(const Context &ctx, const detail::PowerOfTwoFold &fold, int core_rank, std::byte *data,
+                       const Distribution &blocks) {
+  for (int mask = 1; mask < fold.core_size; mask <<= 1) {
+    const int partner = fold.CommRank(core_rank ^ mask);
+    const int mine = core_rank & ~(mask - 1);
+    const int theirs = mine ^ mask;
+    const auto send = BlockRange(blocks, mine, mine + mask);
+    const auto recv = BlockRange(blocks, theirs, theirs + mask);
+    ctx.Exchange(ctx.At(data, send.offset), send.count, partner, ctx.At(data, recv.offset), recv.count, partner);
+  }
+}
+
+/// Reduce-scatter by recursive halving, then a direct gather of the blocks on the root.
+void ReduceRabenseifner(const Context &ctx, std::byte *acc, void *recv, int count, MPI_Op op, int root) {
+  const auto fold = detail::MakePowerOfTwoFold(ctx.size);
+  const auto blocks = BlockDistribution(static_cast<std::size_t>(count), fold.core_size);
+  std::vector<std::byte> tmp(ctx.Bytes(count));
+  FoldIn(ctx, fold, acc, tmp.data(), count, op);
+  const int core_rank = fold.CoreRank(ctx.rank);
+  if (core_rank >= 0) {
+    ReduceScatterHalving(ctx, fold, core_rank, acc, tmp.data(), blocks, op);
+  }
+  if (ctx.rank == root) {
+    std::vector<MPI_Request> requests;
+    for (int block = 0; block < fold.core_size; block++) {
+      const int source = fold.CommRank(block);
+      if (source != ctx.rank) {
+        const auto range = BlockRange(blocks, block, block + 1);
+        MPI_Irecv(ctx.At(recv, range.offset), range.count, ctx.type, source, kCollectiveTag, ctx.comm,
+                  &requests.emplace_back());
+      }
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+  } else if (core_rank >= 0) {
+    const auto range = BlockRange(blocks, core_rank, core_rank + 1);
+    ctx.Send(ctx.At(acc, range.offset), range.count, root);
+  }
+}
+
+void AllreduceRecursiveDoubling(const Context &ctx, std::byte *acc, int count, MPI_Op op) {
+  const auto fold = detail::MakePowerOfTwoFold(ctx.size);
+  std::vector<std::byte> tmp(ctx.Bytes(count));
+  FoldIn(ctx, fold, acc, tmp.data(), count, op);
+  const int core_rank = fold.CoreRank(ctx.rank);
+  if (core_rank >= 0) {
+    for (int mask = 1; mask < fold.core_size; mask <<= 1) {
+      const int partner = fold.CommRank(core_rank ^ mask);
+      ctx.Exchange(acc, count, partner, tmp.data(), count, partner);
+      ctx.ReduceLocal(tmp.data(), acc, count, op);
+    }
+  }
+  FoldOut(ctx, fold, acc, count);
+}
+
+void AllreduceRabenseifner(const Context &ctx, std::byte *acc, int count, MPI_Op op) {
+  const auto fold = detail::MakePowerOfTwoFold(ctx.size);
+  const auto blocks = BlockDistribution(static_cast<std::size_t>(count), fold.core_size);
+  std::vector<std::byte> tmp(ctx.Bytes(count));
+  FoldIn(ctx, fold, acc, tmp.data(), count, op);
+  const int core_rank = fold.CoreRank(ctx.rank);
+  if (core_rank >= 0) {
+    ReduceScatterHalving(ctx, fold, core_rank, acc, tmp.data(), blocks, op);
+    AllgatherDoubling(ctx, fold, core_rank, acc, blocks);
+  }
+  FoldOut(ctx, fold, acc, count);
+}
+
+/// Ring reduce-scatter (rank r ends with block r + 1 complete) followed by a ring allgather.
+void AllreduceRing(const Context &ctx, std::byte *acc, int count, MPI_Op op) {
+  const auto blocks = BlockDistribution(static_cast<std::size_t>(count), ctx.size);
+  std::vector<std::byte> tmp(ctx.Bytes(count));
+  const int right = (ctx.rank + 1) % ctx.size;
+  const int left = (ctx.rank - 1 + ctx.size) % ctx.size;
+  for (int step = 0; step + 1 < ctx.size; step++) {
+    const int send_block = (ctx.rank - step + ctx.size) % ctx.size;
+    const int recv_block = (ctx.rank - step - 1 + (2 * ctx.size)) % ctx.size;
+    const auto send = BlockRange(blocks, send_block, send_block + 1);
+    const auto recv = BlockRange(blocks, recv_block, recv_block + 1);
+    ctx.Exchange(ctx.At(acc, send.offset), send.count, right, ctx.At(tmp.data(), recv.offset), recv.count, left);
+    ctx.ReduceLocal(ctx.At(tmp.data(), recv.offset), ctx.At(acc, recv.offset), recv.count, op);
+  }
+  RingAllgather(ctx, acc, blocks, ctx.size - 1);
+}
+
+/// Bruck allgather: after step k every rank holds the blocks of the next 2^k ranks; a final rotation puts
+/// them into rank order.
+void AllgatherBruck(const Context &ctx, void *recv, int count) {
+  const auto block = static_cast<std::size_t>(count);
+  std::vector<std::byte> tmp(ctx.Bytes(block * static_cast<std::size_t>(ctx.size)));
+  std::memcpy(tmp.data(), ctx.At(recv, block * static_cast<std::size_t>(ctx.rank)), ctx.Bytes(block));
+  for (int distance = 1; distance < ctx.size; distance <<= 1) {
+    const int blocks = std::min(distance, ctx.size - distance);
+    ctx.Exchange(tmp.data(), blocks * count, (ctx.rank - distance + ctx.size) % ctx.size,
+                 ctx.At(tmp.data(), block * static_cast<std::size_t>(distance)), blocks * count,
+                 (ctx.rank + distance) % ctx.size);
+  }
+  for (int index = 0; index < ctx.size; index++) {
+    const auto owner = static_cast<std::size_t>((ctx.rank + index) % ctx.size);
+    std::memcpy(ctx.At(recv, block * owner), ctx.At(tmp.data(), block * static_cast<std::size_t>(index)),
+                ctx.Bytes(block));
+  }
+}
+
+void AlltoallPairwise(const Context &ctx, const void *send, void *recv, int count) {
+  const auto block = static_cast<std::size_t>(count);
+  const auto own = static_cast<std::size_t>(ctx.rank);
+  std::memcpy(ctx.At(recv, block * own), ctx.At(send, block * own), ctx.Bytes(block));
+  for (int step = 1; step < ctx.size; step++) {
+    const int dest = (ctx.rank + step) % ctx.size;
+    const int source = (ctx.rank - step + ctx.size) % ctx.size;
+    ctx.Exchange(ctx.At(send, block * static_cast<std::size_t>(dest)), count, dest,
+                 ctx.At(recv, block * static_cast<std::size_t>(source)), count, source);
+  }
+}
+
+/// Bruck alltoall: block i (destined to rank + i) travels i hops, in step k if bit k of i is set. ceil(log2 p)
+/// messages of about half the buffer each instead of p - 1 small ones.
+void AlltoallBruck(const Context &ctx, const void *send, void *recv, int count) {
+  const auto block = static_cast<std::size_t>(count);
+  const auto size = static_cast<std::size_t>(ctx.size);
+  std::vector<std::byte> tmp(ctx.Bytes(block * size));
+  for (std::size_t index = 0; index < size; index++) {
+    const auto dest = (static_cast<std::size_t>(ctx.rank) + index) % size;
+    std::memcpy(ctx.At(tmp.data(), block * index), ctx.At(send, block * dest), ctx.Bytes(block));
+  }
+  std::vector<std::byte> packed(ctx.Bytes(block * ((size / 2) + 1)));
+  std::vector<std::byte> unpacked(packed.size());
+  for (int distance = 1; distance < ctx.size; distance <<= 1) {
+    std::size_t blocks = 0;
+    for (std::size_t index = 0; index < size; index++) {
+      if ((index & static_cast<std::size_t>(distance)) != 0) {
+        std::memcpy(ctx.At(packed.data(), block * blocks++), ctx.At(tmp.data(), block * index), ctx.Bytes(block));
+      }
+    }
+    const int items = static_cast<int>(blocks) * count;
+    ctx.Exchange(packed.data(), items, (ctx.rank + distance) % ctx.size, unpacked.data(), items,
+                 (ctx.rank - distance + ctx.size) % ctx.size);
+    blocks = 0;
+    for (std::size_t index = 0; index < size; index++) {
+      if ((index & static_cast<std::size_t>(distance)) != 0) {
+        std::memcpy(ctx.At(tmp.data(), block * index), ctx.At(unpacked.data(), block * blocks++), ctx.Bytes(block));
+      }
+    }
+  }
+  for (std::size_t index = 0; index < size; index++) {
+    const auto source = (static_cast<std::size_t>(ctx.rank) + size - index) % size;
+    std::memcpy(ctx.At(recv, block * source), ctx.At(tmp.data(), block * index), ctx.Bytes(block));
+  }
+}
+
+bool IsCommutative(MPI_Op op) {
+  int commute = 0;
+  MPI_Op_commutative(op, &commute);
+  return commute != 0;
+}
+
+/// ResolveAlgorithm only returns supported algorithms, so reaching this is a bug in the dispatch.
+[[noreturn]] void ThrowUnresolved(const std::string &operation, Algorithm algorithm) {
+  throw std::logic_error(operation + ": unresolved collective algorithm '" + GetStringAlgorithm(algorithm) + "'");
+}
+
+/// Allgather and alltoall address the whole buffer of size * count items in one call.
+void CheckTotalCount(int count, int size, const char *what) {
+  if (static_cast<std::size_t>(count) * static_cast<std::size_t>(size) > kMaxMessageCount) {
+    throw std::invalid_argument(what);
+  }
+}
+
+}  // namespace
+
+std::string GetStringAlgorithm(Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::kAuto:
+      return "auto";
+    case Algorithm::kNative:
+      return "native";
+    case Algorithm::kBinomial:
+      return "binomial";
+    case Algorithm::kRecursiveDoubling:
+      return "recursive_doubling";
+    case Algorithm::kRing:
+      return "ring";
+    case Algorithm::kRabenseifner:
+      return "rabenseifner";
+    case Algorithm::kBruck:
+      return "bruck";
+    case Algorithm::kPairwise:
+      return "pairwise";
+  }
+  return "unknown";
+}
+
+Algorithm ParseAlgorithm(const std::string &name) {
+  std::string lower = name;
+  std::ranges::transform(lower, lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  for (auto algorithm : kAlgorithms) {
+    if (lower == GetStringAlgorithm(algorithm)) {
+      return algorithm;
+    }
+  }
+  throw std::invalid_argument("Unknown collective algorithm '" + name +
+                              "', expected auto, native, binomial, recursive_doubling, ring, rabenseifner, bruck "
+                              "or pairwise");
+}
+
+Algorithm GetAlgorithmOverride() {
+  const auto val = env::get<std::string>("PPC_COLLECTIVE_ALGORITHM");
+  if (!val.has_value() || val->empty()) {
+    return Algorithm::kAuto;
+  }
+  return ParseAlgorithm(*val);
+}
+
+bool IsSupported(Operation operation, Algorithm algorithm) {
+  if (algorithm == Algorithm::kAuto || algorithm == Algorithm::kNative) {
+    return true;
+  }
+  switch (operation) {
+    case Operation::kBcast:
+      return algorithm == Algorithm::kBinomial || algorithm == Algorithm::kRing;
+    case Operation::kReduce:
+      return algorithm == Algorithm::kBinomial || algorithm == Algorithm::kRabenseifner;
+    case Operation::kAllreduce:
+      return algorithm == Algorithm::kBinomial || algorithm == Algorithm::kRecursiveDoubling ||
+             algorithm == Algorithm::kRing || algorithm == Algorithm::kRabenseifner;
+    case Operation::kAllgather:
+      return algorithm == Algorithm::kRecursiveDoubling || algorithm == Algorithm::kRing ||
+             algorithm == Algorithm::kBruck;
+    case Operation::kAlltoall:
+      return algorithm == Algorithm::kBruck || algorithm == Algorithm::kPairwise;
+  }
+  return false;
+}
+
+Algorithm SelectAlgorithm(Operation operation, std::size_t bytes, int comm_size) {
+  switch (operation) {
+    case Operation::kBcast:
+      return bytes < kBcastLongMessageBytes || comm_size < kBcastMinScatterRanks ? Algorithm::kBinomial
+                                                                                 : Algorithm::kRing;
+    case Operation::kReduce:
+      return bytes <= kShortMessageBytes ? Algorithm::kBinomial : Algorithm::kRabenseifner;
+    case Operation::kAllreduce:
+      if (bytes <= kShortMessageBytes) {
+        return Algorithm::kRecursiveDoubling;
+      }
+      // The fold costs non-power-of-two sizes two extra full-size messages, which the ring avoids
+      if (!IsPowerOfTwo(comm_size) && bytes >= kLongMessageBytes) {
+        return Algorithm::kRing;
+      }
+      return Algorithm::kRabenseifner;
+    case Operation::kAllgather:
+      if (bytes * static_cast<std::size_t>(std::max(comm_size, 1)) < kAllgatherShortBytes) {
+        return IsPowerOfTwo(comm_size) ? Algorithm::kRecursiveDoubling : Algorithm::kBruck;
+      }
+      return Algorithm::kRing;
+    case Operation::kAlltoall:
+      return bytes <= kAlltoallShortBlockBytes && comm_size >= kAlltoallMinBruckRanks ? Algorithm::kBruck
+                                                                                     : Algorithm::kPairwise;
+  }
+  return Algorithm::kNative;
+}
+
+Algorithm ResolveAlgorithm(Operation operation, Algorithm requested, std::size_t bytes, int comm_size) {
+  if (requested == Algorithm::kAuto) {
+    const auto algorithm = GetAlgorithmOverride();
+    if (algorithm != Algorithm::kAuto && IsSupported(operation, algorithm)) {
+      return algorithm;
+    }
+    return SelectAlgorithm(operation, bytes, comm_size);
+  }
+  if (!IsSupported(operation, requested)) {
+    throw std::invalid_argument("Collective algorithm '" + GetStringAlgorithm(requested) +
+                                "' is not available for this operation");
+  }
+  return requested;
+}
+
+namespace detail {
+
+PowerOfTwoFold MakePowerOfTwoFold(int size) {
+  PowerOfTwoFold fold;
+  while (fold.core_size * 2 <= size) {
+    fold.core_size *= 2;
+  }
+  fold.extra = size - fold.core_size;
+  return fold;
+}
+
+void Bcast(void *data, int count, MPI_Datatype type, int root, MPI_Comm comm, Algorithm algorithm) {
+  const auto ctx = MakeContext(comm, type);
+  // Resolved first, so an unsupported algorithm is rejected on a single rank too
+  const auto resolved = ResolveAlgorithm(Operation::kBcast, algorithm, ctx.Bytes(count), ctx.size);
+  if (ctx.size == 1 || count == 0) {
+    return;
+  }
+  switch (resolved) {
+    case Algorithm::kBinomial:
+      BcastBinomial(ctx, data, count, root);
+      return;
+    case Algorithm::kRing:
+      BcastScatterRing(ctx, data, count, root);
+      return;
+    case Algorithm::kNative:
+      MPI_Bcast(data, count, type, root, comm);
+      return;
+    case Algorithm::kAuto:
+    case Algorithm::kRecursiveDoubling:
+    case Algorithm::kRabenseifner:
+    case Algorithm::kBruck:
+    case Algorithm::kPairwise:
+      ThrowUnresolved("Bcast", resolved);
+  }
+}
+
+void Reduce(const void *send, void *recv, int count, MPI_Datatype type, MPI_Op op, int root, MPI_Comm comm,
+            Algorithm algorithm) {
+  const auto ctx = MakeContext(comm, type);
+  auto resolved = ResolveAlgorithm(Operation::kReduce, algorithm, ctx.Bytes(count), ctx.size);
+  if (!IsCommutative(op)) {
+    resolved = Algorithm::kNative;
+  }
+  if (resolved == Algorithm::kNative) {
+    MPI_Reduce(send, recv, count, type, op, root, comm);
+    return;
+  }
+  std::vector<std::byte> storage;
+  auto *acc = PrepareAccumulator(ctx, send, recv, count, ctx.rank == root, storage);
+  if (resolved == Algorithm::kRabenseifner) {
+    ReduceRabenseifner(ctx, acc, recv, count, op, root);
+  } else {
+    ReduceBinomial(ctx, acc, count, op, root);
+  }
+}
+
+void Allreduce(const void *send, void *recv, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+               Algorithm algorithm) {
+  const auto ctx = MakeContext(comm, type);
+  auto resolved = ResolveAlgorithm(Operation::kAllreduce, algorithm, ctx.Bytes(count), ctx.size);
+  if (!IsCommutative(op)) {
+    resolved = Algorithm::kNative;
+  }
+  if (resolved == Algorithm::kNative) {
+    MPI_Allreduce(send, recv, count, type, op, comm);
+    return;
+  }
+  std::vector<std::byte> storage;
+  auto *acc = PrepareAccumulator(ctx, send, recv, count, true, storage);
+  switch (resolved) {
+    case Algorithm::kBinomial:
+      ReduceBinomial(ctx, acc, count, op, 0);
+      BcastBinomial(ctx, acc, count, 0);
+      return;
+    case Algorithm::kRecursiveDoubling:
+      AllreduceRecursiveDoubling(ctx, acc, count, op);
+      return;
+    case Algorithm::kRing:
+      AllreduceRing(ctx, acc, count, op);
+      return;
+    case Algorithm::kRabenseifner:
+      AllreduceRabenseifner(ctx, acc, count, op);
+      return;
+    case Algorithm::kAuto:
+    case Algorithm::kNative:
+    case Algorithm::kBruck:
+    case Algorithm::kPairwise:
+      ThrowUnresolved("Allreduce", resolved);
+  }
+}
+
+void Allgather(const void *send, void *recv, int count, MPI_Datatype type, MPI_Comm comm, Algorithm algorithm) {
+  const auto ctx = MakeContext(comm, type);
+  CheckTotalCount(count, ctx.size, "Allgather: the result does not fit into a single MPI call");
+  const auto resolved = ResolveAlgorithm(Operation::kAllgather, algorithm, ctx.Bytes(count), ctx.size);
+  if (resolved == Algorithm::kNative) {
+    MPI_Allgather(send, count, type, recv, count, type, comm);
+    return;
+  }
+  const auto block = static_cast<std::size_t>(count);
+  if (send != MPI_IN_PLACE) {
+    std::memcpy(ctx.At(recv, block * static_cast<std::size_t>(ctx.rank)), send, ctx.Bytes(block));
+  }
+  const auto blocks = MakeDistribution(std::vector<std::size_t>(static_cast<std::size_t>(ctx.size), block));
+  if (resolved == Algorithm::kRing) {
+    RingAllgather(ctx, recv, blocks, 0);
+  } else if (resolved == Algorithm::kRecursiveDoubling && IsPowerOfTwo(ctx.size)) {
+    AllgatherDoubling(ctx, MakePowerOfTwoFold(ctx.size), ctx.rank, static_cast<std::byte *>(recv), blocks);
+  } else {
+    AllgatherBruck(ctx, recv, count);
+  }
+}
+
+void Alltoall(const void *send, void *recv, int count, MPI_Datatype type, MPI_Comm comm, Algorithm algorithm) {
+  const auto ctx = MakeContext(comm, type);
+  CheckTotalCount(count, ctx.size, "Alltoall: the buffer does not fit into a single MPI call");
+  const auto resolved = ResolveAlgorithm(Operation::kAlltoall, algorithm, ctx.Bytes(count), ctx.size);
+  switch (resolved) {
+    case Algorithm::kBruck:
+      AlltoallBruck(ctx, send, recv, count);
+      return;
+    case Algorithm::kPairwise:
+      AlltoallPairwise(ctx, send, recv, count);
+      return;
+    case Algorithm::kNative:
+      MPI_Alltoall(send, count, type, recv, count, type, comm);
+      return;
+    case Algorithm::kAuto:
+    case Algorithm::kBinomial:
+    case Algorithm::kRecursiveDoubling:
+    case Algorithm::kRing:
+    case Algorithm::kRabenseifner:
+      ThrowUnresolved("Alltoall", resolved);
+  }
+}
+
+int ToCount(std::size_t size, const TypeInfo &type) {
+  if (size > kMaxMessageCount / type.units) {
+    throw std::invalid_argument("The buffer does not fit into a single MPI call");
+  }
+  return static_cast<int>(size * type.units);
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  return size;
+}
+
+}  // namespace detail
+
+}  // namespace ppc::mpi::coll
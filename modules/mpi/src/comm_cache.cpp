@@ -0,0 +1,216 @@
+#include "mpi/include/comm_cache.hpp"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <set>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace ppc::mpi {
+
+namespace {
+
+enum CommKind : int { kHypercube, kCart, kCartSub, kShared, kCollective };
+
+/// Sub-communicators of one parent, stored as an attribute of the parent.
+struct CommEntry {
+  std::map<std::vector<int>, MPI_Comm> comms;
+};
+
+using TypeKey = std::tuple<int, int, int, MPI_Datatype, std::ptrdiff_t>;
+
+struct Registry {
+  // Recursive: freeing a cached communicator runs the delete callback of its own cached children
+  std::recursive_mutex mutex;
+  int comm_keyval = MPI_KEYVAL_INVALID;
+  bool finalize_hook = false;
+  std::set<MPI_Comm> parents;
+  std::map<TypeKey, MPI_Datatype> types;
+};
+
+Registry &GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+int DeleteCommEntry(MPI_Comm comm, int /*keyval*/, void *attribute, void * /*extra_state*/) {
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  auto *entry = static_cast<CommEntry *>(attribute);
+  for (auto &[key, sub_comm] : entry->comms) {
+    if (sub_comm != MPI_COMM_NULL) {
+      MPI_Comm_free(&sub_comm);
+    }
+  }
+  registry.parents.erase(comm);
+  delete entry;
+  return MPI_SUCCESS;
+}
+
+/// MPI_Finalize deletes the attributes of MPI_COMM_SELF first, while MPI is still usable.
+int ClearOnFinalize(MPI_Comm /*comm*/, int /*keyval*/, void * /*attribute*/, void * /*extra_state*/) {
+  ClearCommCache();
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  MPI_Comm_free_keyval(&registry.comm_keyval);
+  registry.finalize_hook = false;
+  return MPI_SUCCESS;
+}
+
+void EnsureKeyvals(Registry &registry) {
+  if (registry.comm_keyval == MPI_KEYVAL_INVALID) {
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, DeleteCommEntry, &registry.comm_keyval, nullptr);
+  }
+  if (!registry.finalize_hook) {
+    int keyval = MPI_KEYVAL_INVALID;
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, ClearOnFinalize, &keyval, nullptr);
+    MPI_Comm_set_attr(MPI_COMM_SELF, keyval, nullptr);
+    // The attribute keeps the keyval alive until MPI_Finalize deletes it
+    MPI_Comm_free_keyval(&keyval);
+    registry.finalize_hook = true;
+  }
+}
+
+CommEntry &GetEntry(Registry &registry, MPI_Comm comm) {
+  EnsureKeyvals(registry);
+  void *attribute = nullptr;
+  int found = 0;
+  MPI_Comm_get_attr(comm, registry.comm_keyval, &attribute, &found);
+  if (found != 0) {
+    return *static_cast<CommEntry *>(attribute);
+  }
+  auto *entry = new CommEntry();
+  MPI_Comm_set_attr(comm, registry.comm_keyval, entry);
+  registry.parents.insert(comm);
+  return *entry;
+}
+
+template <typename Create>
+MPI_Comm GetOrCreate(MPI_Comm comm, const std::vector<int> &key, Create &&create) {
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  auto &entry = GetEntry(registry, comm);
+  if (auto it = entry.comms.find(key); it != entry.comms.end()) {
+    return it->second;
+  }
+  MPI_Comm sub_comm = create();
+  entry.comms.emplace(key, sub_comm);
+  return sub_comm;
+}
+
+}  // namespace
+
+MPI_Comm GetHypercubeComm(MPI_Comm comm, int dim) {
+  return GetOrCreate(comm, {kHypercube, dim}, [comm, dim] {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm sub_comm = MPI_COMM_NULL;
+    MPI_Comm_split(comm, rank & ~(1 << dim), rank, &sub_comm);
+    return sub_comm;
+  });
+}
+
+MPI_Comm GetCartComm(MPI_Comm comm, std::span<const int> dims, std::span<const int> periods) {
+  std::vector<int> key = {kCart};
+  key.insert(key.end(), dims.begin(), dims.end());
+  key.insert(key.end(), periods.begin(), periods.end());
+  return GetOrCreate(comm, key, [comm, dims, periods] {
+    MPI_Comm cart_comm = MPI_COMM_NULL;
+    MPI_Cart_create(comm, static_cast<int>(dims.size()), dims.data(), periods.data(), 0, &cart_comm);
+    return cart_comm;
+  });
+}
+
+MPI_Comm GetCartSubComm(MPI_Comm cart_comm, std::span<const int> remain_dims) {
+  std::vector<int> key = {kCartSub};
+  key.insert(key.end(), remain_dims.begin(), remain_dims.end());
+  return GetOrCreate(cart_comm, key, [cart_comm, remain_dims] {
+    MPI_Comm sub_comm = MPI_COMM_NULL;
+    MPI_Cart_sub(cart_comm, remain_dims.data(), &sub_comm);
+    return sub_comm;
+  });
+}
+
+MPI_Comm GetSharedComm(MPI_Comm comm) {
+  return GetOrCreate(comm, {kShared}, [comm] {
+    int rank = 0;
+    int size = 0;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    MPI_Comm node_comm = MPI_COMM_NULL;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+    int node_size = 0;
+    MPI_Comm_size(node_comm, &node_size);
+    // Every rank sees node_size < size as soon as one node holds fewer than all ranks, so all agree
+    if (node_size != size) {
+      MPI_Comm_free(&node_comm);
+    }
+    return node_comm;
+  });
+}
+
+MPI_Comm GetCollectiveComm(MPI_Comm comm) {
+  return GetOrCreate(comm, {kCollective}, [comm] {
+    MPI_Comm dup_comm = MPI_COMM_NULL;
+    MPI_Comm_dup(comm, &dup_comm);
+    return dup_comm;
+  });
+}
+
+MPI_Datatype GetVectorType(int count, int blocklength, int stride, MPI_Datatype base, std::ptrdiff_t extent) {
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  EnsureKeyvals(registry);
+  const TypeKey key{count, blocklength, stride, base, extent};
+  if (auto it = registry.types.find(key); it != registry.types.end()) {
+    return it->second;
+  }
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_vector(count, blocklength, stride, base, &type);
+  if (extent != 0) {
+    MPI_Aint lower_bound = 0;
+    MPI_Aint base_extent = 0;
+    MPI_Type_get_extent(base, &lower_bound, &base_extent);
+    MPI_Datatype resized = MPI_DATATYPE_NULL;
+    MPI_Type_create_resized(type, 0, static_cast<MPI_Aint>(extent) * base_extent, &resized);
+    MPI_Type_free(&type);
+    type = resized;
+  }
+  MPI_Type_commit(&type);
+  registry.types.emplace(key, type);
+  return type;
+}
+
+void ClearCommCache() {
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  // Deleting the attribute runs DeleteCommEntry, which erases the parent from the set
+  while (!registry.parents.empty()) {
+    MPI_Comm_delete_attr(*registry.parents.begin(), registry.comm_keyval);
+  }
+  for (auto &[key, type] : registry.types) {
+    MPI_Type_free(&type);
+  }
+  registry.types.clear();
+}
+
+std::size_t GetCommCacheSize() {
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  std::size_t size = registry.types.size();
+  for (MPI_Comm parent : registry.parents) {
+    void *attribute = nullptr;
+    int found = 0;
+    MPI_Comm_get_attr(parent, registry.comm_keyval, &attribute, &found);
+    if (found != 0) {
+      size += static_cast<CommEntry *>(attribute)->comms.size();
+    }
+  }
+  return size;
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,289 @@
+#include "mpi/include/distribution.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+#include "task/include/block_range.hpp"
+
+namespace ppc::mpi {
+
+namespace {
+
+constexpr int kSegmentTag = 0x5e9;
+
+void CheckParts(int parts) {
+  if (parts <= 0) {
+    throw std::invalid_argument("Number of parts must be positive");
+  }
+}
+
+/// Converts the distribution to the int arrays of the MPI_*v collectives, in items of the MPI datatype.
+void ToIntArrays(const Distribution &dist, std::size_t units, std::vector<int> &counts, std::vector<int> &displs) {
+  counts.resize(dist.counts.size());
+  displs.resize(dist.displs.size());
+  for (std::size_t part = 0; part < dist.counts.size(); part++) {
+    counts[part] = static_cast<int>(dist.counts[part] * units);
+    displs[part] = static_cast<int>(dist.displs[part] * units);
+  }
+}
+
+/// Calls fn(pointer, count) for consecutive segments of at most max_count items covering count items.
+template <typename Pointer, typename Fn>
+void ForEachSegment(Pointer ptr, std::size_t count, const TypeInfo &type, std::size_t max_count, Fn &&fn) {
+  const std::size_t item_bytes = type.bytes / type.units;
+  for (std::size_t done = 0; done < count;) {
+    const std::size_t len = std::min(count - done, max_count);
+    fn(ptr + (done * item_bytes), static_cast<int>(len));
+    done += len;
+  }
+}
+
+}  // namespace
+
+bool Distribution::FitsInt(std::size_t units) const {
+  const auto max = static_cast<std::size_t>(INT_MAX) / std::max<std::size_t>(units, 1);
+  return std::ranges::all_of(counts, [max](std::size_t count) { return count <= max; }) &&
+         std::ranges::all_of(displs, [max](std::size_t displ) { return displ <= max; });
+}
+
+Distribution MakeDistribution(std::vector<std::size_t> counts) {
+  Distribution dist;
+  dist.displs.resize(counts.size());
+  std::size_t offset = 0;
+  for (std::size_t part = 0; part < counts.size(); part++) {
+    dist.displs[part] = offset;
+    offset += counts[part];
+  }
+  dist.counts = std::move(counts);
+  return dist;
+}
+
+Distribution BlockDistribution(std::size_t items, int parts, std::size_t item_size) {
+  CheckParts(parts);
+  const auto num_parts = static_cast<std::size_t>(parts);
+  std::vector<std::size_t> counts(num_parts);
+  for (std::size_t part = 0; part < num_parts; part++) {
+    counts[part] = ppc::task::GetBlockRange(items, part, num_parts).Size() * item_size;
+  }
+  return MakeDistribution(std::move(counts));
+}
+
+BlockPartition::BlockPartition(std::size_t size, int parts)
+    : size_(size), parts_(parts), distribution_(BlockDistribution(size, parts)) {}
+
+int BlockPartition::Owner(std::size_t index) const {
+  const auto parts = static_cast<std::size_t>(parts_);
+  const std::size_t base = size_ / parts;
+  const std::size_t extra = size_ % parts;
+  // The first `extra` parts hold base + 1 elements
+  const std::size_t split = extra * (base + 1);
+  if (index < split) {
+    return static_cast<int>(index / (base + 1));
+  }
+  return static_cast<int>(extra + ((index - split) / base));
+}
+
+std::size_t BlockPartition::LocalSize(int part) const {
+  return distribution_.counts.at(static_cast<std::size_t>(part));
+}
+
+std::size_t BlockPartition::ToLocal(std::size_t index) const {
+  return index - distribution_.displs[static_cast<std::size_t>(Owner(index))];
+}
+
+std::size_t BlockPartition::ToGlobal(int part, std::size_t local) const {
+  return distribution_.displs.at(static_cast<std::size_t>(part)) + local;
+}
+
+BlockCyclicPartition::BlockCyclicPartition(std::size_t size, int parts, std::size_t block_size)
+    : size_(size), parts_(parts), block_size_(block_size) {
+  CheckParts(parts);
+  if (block_size == 0) {
+    throw std::invalid_argument("Block size must be positive");
+  }
+  std::vector<std::size_t> counts(static_cast<std::size_t>(parts));
+  for (int part = 0; part < parts; part++) {
+    counts[static_cast<std::size_t>(part)] = LocalSize(part);
+  }
+  distribution_ = MakeDistribution(std::move(counts));
+}
+
+int BlockCyclicPartition::Owner(std::size_t index) const {
+  return static_cast<int>((index / block_size_) % static_cast<std::size_t>(parts_));
+}
+
+std::size_t BlockCyclicPartition::LocalSize(int part) const {
+  if (part < 0 || part >= parts_) {
+    throw std::out_of_range("Part index is out of range");
+  }
+  const auto parts = static_cast<std::size_t>(parts_);
+  const auto p = static_cast<std::size_t>(part);
+  const std::size_t blocks = (size_ + block_size_ - 1) / block_size_;
+  const std::size_t owned = (blocks / parts) + (p < blocks % parts ? 1 : 0);
+  if (owned == 0) {
+    return 0;
+  }
+  std::size_t local = owned * block_size_;
+  // The last block may be short
+  if (const std::size_t tail = size_ % block_size_; tail != 0 && (blocks - 1) % parts == p) {
+    local -= block_size_ - tail;
+  }
+  return local;
+}
+
+std::size_t BlockCyclicPartition::ToLocal(std::size_t index) const {
+  const std::size_t block = index / block_size_;
+  return ((block / static_cast<std::size_t>(parts_)) * block_size_) + (index % block_size_);
+}
+
+std::size_t BlockCyclicPartition::ToGlobal(int part, std::size_t local) const {
+  const std::size_t block = ((local / block_size_) * static_cast<std::size_t>(parts_)) + static_cast<std::size_t>(part);
+  return (block * block_size_) + (local % block_size_);
+}
+
+std::size_t BroadcastSize(std::size_t size, int root, MPI_Comm comm) {
+  auto value = static_cast<std::uint64_t>(size);
+  MPI_Bcast(&value, 1, MPI_UINT64_T, root, comm);
+  return static_cast<std::size_t>(value);
+}
+
+namespace detail {
+
+int CommRank(MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  return rank;
+}
+
+void CheckCommSize(const Distribution &dist, MPI_Comm comm) {
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  if (dist.Parts() != size) {
+    throw std::invalid_argument("Distribution has " + std::to_string(dist.Parts()) + " parts for " +
+                                std::to_string(size) + " ranks");
+  }
+}
+
+void StartSegmentedScatterv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, int root,
+                            MPI_Comm comm, bool in_place, std::size_t max_count, std::vector<MPI_Request> &requests) {
+  const int rank = CommRank(comm);
+  const auto own = static_cast<std::size_t>(rank);
+  const auto *send_bytes = static_cast<const char *>(send);
+  auto *recv_bytes = static_cast<char *>(recv);
+  if (rank == root) {
+    for (int part = 0; part < dist.Parts(); part++) {
+      const auto p = static_cast<std::size_t>(part);
+      const char *begin = send_bytes + (dist.displs[p] * type.bytes);
+      if (part == root) {
+        if (!in_place && dist.counts[p] != 0) {
+          std::memcpy(recv_bytes, begin, dist.counts[p] * type.bytes);
+        }
+        continue;
+      }
+      ForEachSegment(begin, dist.counts[p] * type.units, type, max_count, [&](const char *ptr, int count) {
+        MPI_Isend(ptr, count, type.type, part, kSegmentTag, comm, &requests.emplace_back());
+      });
+    }
+  } else {
+    ForEachSegment(recv_bytes, dist.counts[own] * type.units, type, max_count, [&](char *ptr, int count) {
+      MPI_Irecv(ptr, count, type.type, root, kSegmentTag, comm, &requests.emplace_back());
+    });
+  }
+}
+
+void Scatterv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, int root, MPI_Comm comm,
+              bool in_place, std::size_t max_count) {
+  CheckCommSize(dist, comm);
+  const int rank = CommRank(comm);
+  const auto own = static_cast<std::size_t>(rank);
+  if (dist.FitsInt(type.units) && max_count >= static_cast<std::size_t>(INT_MAX)) {
+    std::vector<int> counts;
+    std::vector<int> displs;
+    ToIntArrays(dist, type.units, counts, displs);
+    void *recv_buf = (in_place && rank == root) ? MPI_IN_PLACE : recv;
+    MPI_Scatterv(send, counts.data(), displs.data(), type.type, recv_buf, counts[own], type.type, root, comm);
+    return;
+  }
+
+  std::vector<MPI_Request> requests;
+  StartSegmentedScatterv(send, recv, dist, type, root, comm, in_place, max_count, requests);
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+void Gatherv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, int root, MPI_Comm comm,
+             bool in_place, std::size_t max_count) {
+  CheckCommSize(dist, comm);
+  const int rank = CommRank(comm);
+  const auto own = static_cast<std::size_t>(rank);
+  if (dist.FitsInt(type.units) && max_count >= static_cast<std::size_t>(INT_MAX)) {
+    std::vector<int> counts;
+    std::vector<int> displs;
+    ToIntArrays(dist, type.units, counts, displs);
+    const void *send_buf = (in_place && rank == root) ? MPI_IN_PLACE : send;
+    MPI_Gatherv(send_buf, counts[own], type.type, recv, counts.data(), displs.data(), type.type, root, comm);
+    return;
+  }
+
+  const auto *send_bytes = static_cast<const char *>(send);
+  auto *recv_bytes = static_cast<char *>(recv);
+  std::vector<MPI_Request> requests;
+  if (rank == root) {
+    for (int part = 0; part < dist.Parts(); part++) {
+      const auto p = static_cast<std::size_t>(part);
+      char *begin = recv_bytes + (dist.displs[p] * type.bytes);
+      if (part == root) {
+        if (!in_place && dist.counts[p] != 0) {
+          std::memcpy(begin, send_bytes, dist.counts[p] * type.bytes);
+        }
+        continue;
+      }
+      ForEachSegment(begin, dist.counts[p] * type.units, type, max_count, [&](char *ptr, int count) {
+        MPI_Irecv(ptr, count, type.type, part, kSegmentTag, comm, &requests.emplace_back());
+      });
+    }
+  } else {
+    ForEachSegment(send_bytes, dist.counts[own] * type.units, type, max_count, [&](const char *ptr, int count) {
+      MPI_Isend(ptr, count, type.type, root, kSegmentTag, comm, &requests.emplace_back());
+    });
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+void Allgatherv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, MPI_Comm comm,
+                bool in_place, std::size_t max_count) {
+  CheckCommSize(dist, comm);
+  const auto own = static_cast<std::size_t>(CommRank(comm));
+  if (dist.FitsInt(type.units) && max_count >= static_cast<std::size_t>(INT_MAX)) {
+    std::vector<int> counts;
+    std::vector<int> displs;
+    ToIntArrays(dist, type.units, counts, displs);
+    MPI_Allgatherv(in_place ? MPI_IN_PLACE : send, counts[own], type.type, recv, counts.data(), displs.data(),
+                   type.type, comm);
+    return;
+  }
+
+  auto *recv_bytes = static_cast<char *>(recv);
+  if (!in_place && dist.counts[own] != 0) {
+    std::memcpy(recv_bytes + (dist.displs[own] * type.bytes), send, dist.counts[own] * type.bytes);
+  }
+  // Every rank broadcasts its part; the segments keep each call below max_count
+  for (int part = 0; part < dist.Parts(); part++) {
+    const auto p = static_cast<std::size_t>(part);
+    ForEachSegment(recv_bytes + (dist.displs[p] * type.bytes), dist.counts[p] * type.units, type, max_count,
+                   [&](char *ptr, int count) { MPI_Bcast(ptr, count, type.type, part, comm); });
+  }
+}
+
+}  // namespace detail
+
+}  // namespace ppc::mpi
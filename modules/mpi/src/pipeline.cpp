@@ -0,0 +1,81 @@
+#include "mpi/include/pipeline.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <libenvpp/detail/get.hpp>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+#include "mpi/include/distribution.hpp"
+#include "task/include/block_range.hpp"
+
+namespace ppc::mpi {
+
+std::size_t AutoPipelineChunks(std::size_t part_bytes) {
+  return std::clamp<std::size_t>(part_bytes / kPipelineMinChunkBytes, 1, kPipelineMaxChunks);
+}
+
+std::size_t GetPipelineChunksOverride() {
+  const auto val = env::get<std::size_t>("PPC_PIPELINE_CHUNKS");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 0;
+}
+
+std::size_t GetPipelineChunks(const Distribution &dist, const TypeInfo &type) {
+  const std::size_t max_part = dist.counts.empty() ? 0 : std::ranges::max(dist.counts);
+  std::size_t chunks = GetPipelineChunksOverride();
+  if (chunks == 0) {
+    chunks = AutoPipelineChunks(max_part * type.bytes);
+  }
+  // Every chunk has to fit into a single MPI call
+  const std::size_t max_items = kMaxMessageCount / type.units;
+  return std::max(chunks, (max_part + max_items - 1) / max_items);
+}
+
+Distribution ChunkDistribution(const Distribution &dist, std::size_t chunk, std::size_t chunks) {
+  Distribution result;
+  result.counts.resize(dist.counts.size());
+  result.displs.resize(dist.displs.size());
+  for (std::size_t part = 0; part < dist.counts.size(); part++) {
+    const auto range = ppc::task::GetBlockRange(dist.counts[part], chunk, chunks);
+    result.counts[part] = range.Size();
+    result.displs[part] = dist.displs[part] + range.begin;
+  }
+  return result;
+}
+
+namespace detail {
+
+void StartScatterv(const void *send, void *recv, const Distribution &dist, const TypeInfo &type, int root,
+                   MPI_Comm comm, PendingScatter &pending) {
+  CheckCommSize(dist, comm);
+  const int rank = CommRank(comm);
+  pending.requests.clear();
+  Distribution rebased = dist;
+  const std::size_t base = dist.displs.empty() ? 0 : std::ranges::min(dist.displs);
+  for (auto &displ : rebased.displs) {
+    displ -= base;
+  }
+  const void *chunk_send = rank == root ? static_cast<const char *>(send) + (base * type.bytes) : send;
+  if (!rebased.FitsInt(type.units)) {
+    StartSegmentedScatterv(chunk_send, recv, rebased, type, root, comm, false, kMaxMessageCount, pending.requests);
+    return;
+  }
+  pending.counts.resize(dist.counts.size());
+  pending.displs.resize(dist.displs.size());
+  for (std::size_t part = 0; part < dist.counts.size(); part++) {
+    pending.counts[part] = static_cast<int>(rebased.counts[part] * type.units);
+    pending.displs[part] = static_cast<int>(rebased.displs[part] * type.units);
+  }
+  const auto own = static_cast<std::size_t>(rank);
+  MPI_Iscatterv(chunk_send, pending.counts.data(), pending.displs.data(), type.type, recv, pending.counts[own],
+                type.type, root, comm, &pending.requests.emplace_back());
+}
+
+}  // namespace detail
+
+}  // namespace ppc::mpi
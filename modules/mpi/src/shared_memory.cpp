@@ -0,0 +1,105 @@
+#include "mpi/include/shared_memory.hpp"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+
+#include "mpi/include/comm_cache.hpp"
+
+namespace ppc::mpi {
+
+namespace {
+
+/// Windows kept by SharedWindow::GetCached(), by owner; an attribute of the node communicator.
+using WindowCache = std::map<int, std::unique_ptr<SharedWindow>>;
+
+int DeleteWindowCache(MPI_Comm /*comm*/, int /*keyval*/, void *attribute, void * /*extra_state*/) {
+  delete static_cast<WindowCache *>(attribute);
+  return MPI_SUCCESS;
+}
+
+WindowCache &GetWindowCache(MPI_Comm node_comm) {
+  static const int kKeyval = [] {
+    int keyval = MPI_KEYVAL_INVALID;
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, DeleteWindowCache, &keyval, nullptr);
+    return keyval;
+  }();
+  void *attribute = nullptr;
+  int found = 0;
+  MPI_Comm_get_attr(node_comm, kKeyval, &attribute, &found);
+  if (found != 0) {
+    return *static_cast<WindowCache *>(attribute);
+  }
+  auto *cache = new WindowCache();
+  MPI_Comm_set_attr(node_comm, kKeyval, cache);
+  return *cache;
+}
+
+}  // namespace
+
+bool IsSharedMemoryComm(MPI_Comm comm) {
+  return GetSharedComm(comm) != MPI_COMM_NULL;
+}
+
+std::unique_ptr<SharedWindow> SharedWindow::Allocate(MPI_Comm node_comm, int owner, std::size_t bytes) {
+  std::unique_ptr<SharedWindow> window(new SharedWindow());
+  window->comm_ = node_comm;
+  window->bytes_ = bytes;
+
+  int rank = 0;
+  MPI_Comm_rank(node_comm, &rank);
+  void *base = nullptr;
+  MPI_Win_allocate_shared(static_cast<MPI_Aint>(rank == owner ? bytes : 0), 1, MPI_INFO_NULL, node_comm, &base,
+                          &window->win_);
+  MPI_Aint size = 0;
+  int disp_unit = 0;
+  MPI_Win_shared_query(window->win_, owner, &size, &disp_unit, &base);
+  window->data_ = static_cast<std::byte *>(base);
+  // A passive epoch for the window's lifetime lets Publish() use the MPI_Win_sync + barrier idiom
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, window->win_);
+  return window;
+}
+
+std::shared_ptr<SharedWindow> SharedWindow::Create(MPI_Comm comm, int owner, std::size_t bytes) {
+  MPI_Comm node_comm = GetSharedComm(comm);
+  if (node_comm == MPI_COMM_NULL) {
+    return nullptr;
+  }
+  return Allocate(node_comm, owner, bytes);
+}
+
+SharedWindow *SharedWindow::GetCached(MPI_Comm comm, int owner, std::size_t bytes) {
+  MPI_Comm node_comm = GetSharedComm(comm);
+  if (node_comm == MPI_COMM_NULL) {
+    return nullptr;
+  }
+  auto &window = GetWindowCache(node_comm)[owner];
+  if (window == nullptr || window->bytes_ < bytes) {
+    // Free the old window first so that the node never holds both
+    window.reset();
+    window = Allocate(node_comm, owner, bytes);
+  }
+  return window.get();
+}
+
+SharedWindow::~SharedWindow() {
+  if (win_ != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(win_);
+    MPI_Win_free(&win_);
+  }
+}
+
+void SharedWindow::Reclaim() {
+  MPI_Win_sync(win_);
+  MPI_Barrier(comm_);
+}
+
+void SharedWindow::Publish() {
+  MPI_Win_sync(win_);
+  MPI_Barrier(comm_);
+  MPI_Win_sync(win_);
+}
+
+}  // namespace ppc::mpi
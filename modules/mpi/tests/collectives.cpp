@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mpi/include/collectives.hpp"
+#include "mpi/tests/mpi_run_test.hpp"
+
+namespace coll = ppc::mpi::coll;
+
+namespace {
+
+class MpiRunCollectivesTest : public ppc::mpi::test::MpiRunTest {};
+
+constexpr std::array kAllAlgorithms = {coll::Algorithm::kAuto,
+                                       coll::Algorithm::kNative,
+                                       coll::Algorithm::kBinomial,
+                                       coll::Algorithm::kRecursiveDoubling,
+                                       coll::Algorithm::kRing,
+                                       coll::Algorithm::kRabenseifner,
+                                       coll::Algorithm::kBruck,
+                                       coll::Algorithm::kPairwise};
+
+/// One item, odd counts, counts that do not split evenly over the ranks and, at 8 bytes per item, counts past
+/// the short, long-broadcast and long-message thresholds of the selector.
+constexpr std::array<std::size_t, 6> kCounts = {1, 3, 17, 301, 2000, 70001};
+
+/// Alltoall counts are per block; they straddle the 256-byte block limit of Bruck in the selector.
+constexpr std::array<std::size_t, 5> kBlockCounts = {1, 2, 5, 33, 1000};
+
+std::vector<std::int64_t> MakeValues(int rank, std::size_t count) {
+  std::vector<std::int64_t> values(count);
+  for (std::size_t i = 0; i < count; i++) {
+    values[i] = (static_cast<std::int64_t>(rank + 1) * 1000003) - static_cast<std::int64_t>(i * 7919);
+  }
+  return values;
+}
+
+int CommRank(MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  return rank;
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  return size;
+}
+
+/// Calls fn(algorithm) for every algorithm the operation accepts, naming the case in failure messages.
+template <typename Fn>
+void ForEachAlgorithm(coll::Operation operation, MPI_Comm comm, std::size_t count, Fn &&fn) {
+  for (auto algorithm : kAllAlgorithms) {
+    if (!coll::IsSupported(operation, algorithm)) {
+      continue;
+    }
+    SCOPED_TRACE("algorithm " + coll::GetStringAlgorithm(algorithm) + ", " + std::to_string(CommSize(comm)) +
+                 " ranks, " + std::to_string(count) + " items");
+    fn(algorithm);
+  }
+}
+
+}  // namespace
+
+TEST(MpiCollectivesTest, FoldCoversEveryRankOnce) {
+  for (int size = 1; size <= 13; size++) {
+    const auto fold = coll::detail::MakePowerOfTwoFold(size);
+    EXPECT_EQ(fold.core_size & (fold.core_size - 1), 0);
+    EXPECT_LE(fold.core_size, size);
+    EXPECT_GT(2 * fold.core_size, size);
+
+    std::set<int> core_ranks;
+    for (int rank = 0; rank < size; rank++) {
+      const int core_rank = fold.CoreRank(rank);
+      if (core_rank < 0) {
+        // Ranks that sit out hand their data to the next rank, which is in the core
+        EXPECT_GE(fold.CoreRank(rank + 1), 0);
+        continue;
+      }
+      EXPECT_EQ(fold.CommRank(core_rank), rank);
+      core_ranks.insert(core_rank);
+    }
+    EXPECT_EQ(static_cast<int>(core_ranks.size()), fold.core_size);
+  }
+}
+
+TEST(MpiCollectivesTest, AlgorithmNamesRoundTrip) {
+  for (auto algorithm : {coll::Algorithm::kAuto, coll::Algorithm::kNative, coll::Algorithm::kBinomial,
+                         coll::Algorithm::kRecursiveDoubling, coll::Algorithm::kRing, coll::Algorithm::kRabenseifner,
+                         coll::Algorithm::kBruck, coll::Algorithm::kPairwise}) {
+    EXPECT_EQ(coll::ParseAlgorithm(coll::GetStringAlgorithm(algorithm)), algorithm);
+  }
+  EXPECT_EQ(coll::ParseAlgorithm("Ring"), coll::Algorithm::kRing);
+  EXPECT_THROW(coll::ParseAlgorithm("butterfly"), std::invalid_argument);
+}
+
+TEST(MpiCollectivesTest, SelectorPicksSupportedAlgorithms) {
+  for (auto operation : {coll::Operation::kBcast, coll::Operation::kReduce, coll::Operation::kAllreduce,
+                         coll::Operation::kAllgather, coll::Operation::kAlltoall}) {
+    for (int size : {2, 3, 8, 12, 64}) {
+      for (std::size_t bytes : {std::size_t{8}, std::size_t{4} << 10, std::size_t{1} << 20}) {
+        const auto algorithm = coll::SelectAlgorithm(operation, bytes, size);
+        EXPECT_NE(algorithm, coll::Algorithm::kAuto);
+        EXPECT_TRUE(coll::IsSupported(operation, algorithm));
+      }
+    }
+  }
+}
+
+TEST(MpiCollectivesTest, SelectorSwitchesWithMessageSizeAndRankCount) {
+  using coll::Algorithm;
+  using coll::Operation;
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kBcast, 8, 64), Algorithm::kBinomial);
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kBcast, std::size_t{1} << 20, 4), Algorithm::kBinomial);
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kBcast, std::size_t{1} << 20, 16), Algorithm::kRing);
+
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAllreduce, 8, 6), Algorithm::kRecursiveDoubling);
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAllreduce, std::size_t{64} << 10, 6), Algorithm::kRabenseifner);
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAllreduce, std::size_t{4} << 20, 8), Algorithm::kRabenseifner);
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAllreduce, std::size_t{4} << 20, 6), Algorithm::kRing);
+
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAllgather, 64, 8), Algorithm::kRecursiveDoubling);
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAllgather, 64, 6), Algorithm::kBruck);
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAllgather, std::size_t{1} << 20, 8), Algorithm::kRing);
+
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAlltoall, 16, 32), Algorithm::kBruck);
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAlltoall, 16, 4), Algorithm::kPairwise);
+  EXPECT_EQ(coll::SelectAlgorithm(Operation::kAlltoall, std::size_t{1} << 20, 32), Algorithm::kPairwise);
+}
+
+TEST(MpiCollectivesTest, ExplicitAlgorithmMustBeSupported) {
+  EXPECT_EQ(coll::ResolveAlgorithm(coll::Operation::kBcast, coll::Algorithm::kRing, 8, 4), coll::Algorithm::kRing);
+  EXPECT_EQ(coll::ResolveAlgorithm(coll::Operation::kAlltoall, coll::Algorithm::kNative, 8, 4),
+            coll::Algorithm::kNative);
+  EXPECT_THROW((void)coll::ResolveAlgorithm(coll::Operation::kBcast, coll::Algorithm::kPairwise, 8, 4),
+               std::invalid_argument);
+  EXPECT_THROW((void)coll::ResolveAlgorithm(coll::Operation::kAllgather, coll::Algorithm::kRabenseifner, 8, 4),
+               std::invalid_argument);
+}
+
+TEST_F(MpiRunCollectivesTest, BcastMatchesNative) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = CommRank(comm);
+    for (auto count : kCounts) {
+      for (int root = 0; root < CommSize(comm); root++) {
+        auto expected = MakeValues(rank, count);
+        MPI_Bcast(expected.data(), static_cast<int>(count), MPI_INT64_T, root, comm);
+        ForEachAlgorithm(coll::Operation::kBcast, comm, count, [&](coll::Algorithm algorithm) {
+          auto data = MakeValues(rank, count);
+          coll::Bcast(std::span<std::int64_t>(data), root, comm, algorithm);
+          EXPECT_EQ(data, expected) << "root " << root;
+        });
+      }
+    }
+  });
+}
+
+TEST_F(MpiRunCollectivesTest, ReduceMatchesNative) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = CommRank(comm);
+    for (auto count : kCounts) {
+      const auto send = MakeValues(rank, count);
+      for (MPI_Op op : {MPI_SUM, MPI_MAX}) {
+        for (int root = 0; root < CommSize(comm); root++) {
+          std::vector<std::int64_t> expected(count);
+          MPI_Reduce(send.data(), expected.data(), static_cast<int>(count), MPI_INT64_T, op, root, comm);
+          ForEachAlgorithm(coll::Operation::kReduce, comm, count, [&](coll::Algorithm algorithm) {
+            std::vector<std::int64_t> recv(count);
+            coll::Reduce(std::span<const std::int64_t>(send), std::span<std::int64_t>(recv), op, root, comm,
+                         algorithm);
+            if (rank == root) {
+              EXPECT_EQ(recv, expected) << "root " << root;
+            }
+          });
+        }
+      }
+    }
+  });
+}
+
+TEST_F(MpiRunCollectivesTest, AllreduceMatchesNative) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = CommRank(comm);
+    for (auto count : kCounts) {
+      const auto send = MakeValues(rank, count);
+      for (MPI_Op op : {MPI_SUM, MPI_MAX}) {
+        std::vector<std::int64_t> expected(count);
+        MPI_Allreduce(send.data(), expected.data(), static_cast<int>(count), MPI_INT64_T, op, comm);
+        ForEachAlgorithm(coll::Operation::kAllreduce, comm, count, [&](coll::Algorithm algorithm) {
+          auto data = send;
+          coll::Allreduce(std::span<std::int64_t>(data), op, comm, algorithm);
+          EXPECT_EQ(data, expected);
+        });
+      }
+    }
+  });
+}
+
+TEST_F(MpiRunCollectivesTest, AllgatherMatchesNative) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = CommRank(comm);
+    for (auto count : kCounts) {
+      const auto local = MakeValues(rank, count);
+      std::vector<std::int64_t> expected(count * static_cast<std::size_t>(CommSize(comm)));
+      MPI_Allgather(local.data(), static_cast<int>(count), MPI_INT64_T, expected.data(), static_cast<int>(count),
+                    MPI_INT64_T, comm);
+      ForEachAlgorithm(coll::Operation::kAllgather, comm, count, [&](coll::Algorithm algorithm) {
+        EXPECT_EQ(coll::Allgather(std::span<const std::int64_t>(local), comm, algorithm), expected);
+      });
+    }
+  });
+}
+
+TEST_F(MpiRunCollectivesTest, AlltoallMatchesNative) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = CommRank(comm);
+    for (auto count : kBlockCounts) {
+      const auto send = MakeValues(rank, count * static_cast<std::size_t>(CommSize(comm)));
+      std::vector<std::int64_t> expected(send.size());
+      MPI_Alltoall(send.data(), static_cast<int>(count), MPI_INT64_T, expected.data(), static_cast<int>(count),
+                   MPI_INT64_T, comm);
+      ForEachAlgorithm(coll::Operation::kAlltoall, comm, count, [&](coll::Algorithm algorithm) {
+        EXPECT_EQ(coll::Alltoall(std::span<const std::int64_t>(send), comm, algorithm), expected);
+      });
+    }
+  });
+}
+
+TEST_F(MpiRunCollectivesTest, RejectsUnsupportedAlgorithmOnOneRank) {
+  std::vector<std::int64_t> data(4);
+  EXPECT_THROW(coll::Bcast(std::span<std::int64_t>(data), 0, MPI_COMM_SELF, coll::Algorithm::kPairwise),
+               std::invalid_argument);
+}
+
+TEST_F(MpiRunCollectivesTest, KeepsMessagesApartFromCallerTraffic) {
+  if (CommSize(MPI_COMM_WORLD) < 2) {
+    GTEST_SKIP() << "Needs at least two ranks";
+  }
+  const int rank = CommRank(MPI_COMM_WORLD);
+  constexpr std::int64_t kCallerValue = -42;
+  std::int64_t received = 0;
+  MPI_Request request = MPI_REQUEST_NULL;
+  if (rank == 1) {
+    // Posted before the broadcast, so it would take the broadcast's message if both shared a context
+    MPI_Irecv(&received, 1, MPI_INT64_T, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &request);
+  }
+  std::vector<std::int64_t> data = MakeValues(rank, 1);
+  coll::Bcast(std::span<std::int64_t>(data), 0, MPI_COMM_WORLD, coll::Algorithm::kBinomial);
+  EXPECT_EQ(data, MakeValues(0, 1));
+  if (rank == 0) {
+    MPI_Send(&kCallerValue, 1, MPI_INT64_T, 1, 0, MPI_COMM_WORLD);
+  }
+  if (rank == 1) {
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    EXPECT_EQ(received, kCallerValue);
+  }
+}
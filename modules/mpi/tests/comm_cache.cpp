@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+
+#include "mpi/include/comm_cache.hpp"
+#include "mpi/tests/mpi_run_test.hpp"
+
+namespace {
+
+class MpiRunCommCacheTest : public ppc::mpi::test::MpiRunTest {};
+
+int CompareComms(MPI_Comm lhs, MPI_Comm rhs) {
+  int result = MPI_UNEQUAL;
+  MPI_Comm_compare(lhs, rhs, &result);
+  return result;
+}
+
+/// MPI_Finalize deletes the attributes of MPI_COMM_SELF in the reverse order they were set, so this one, set
+/// before any test touches the cache, is deleted after the cache's own finalize hook and sees its result.
+int CheckCacheCleared(MPI_Comm /*comm*/, int /*keyval*/, void * /*attribute*/, void * /*extra_state*/) {
+  if (ppc::mpi::GetCommCacheSize() != 0) {
+    std::cerr << "[  ERROR  ] " << ppc::mpi::GetCommCacheSize() << " cached MPI handles left at MPI_Finalize\n";
+    return MPI_ERR_OTHER;
+  }
+  return MPI_SUCCESS;
+}
+
+class FinalizeCheckEnvironment : public ::testing::Environment {
+ public:
+  void SetUp() override {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized == 0 || installed_) {
+      return;
+    }
+    int keyval = MPI_KEYVAL_INVALID;
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, CheckCacheCleared, &keyval, nullptr);
+    MPI_Comm_set_attr(MPI_COMM_SELF, keyval, nullptr);
+    MPI_Comm_free_keyval(&keyval);
+    installed_ = true;
+  }
+
+ private:
+  bool installed_ = false;
+};
+
+[[maybe_unused]] ::testing::Environment *const kFinalizeCheck =
+    ::testing::AddGlobalTestEnvironment(new FinalizeCheckEnvironment());
+
+}  // namespace
+
+TEST_F(MpiRunCommCacheTest, ReturnsCachedHandleOnHit) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const auto before = ppc::mpi::GetCommCacheSize();
+    const MPI_Comm pairs = ppc::mpi::GetHypercubeComm(comm, 0);
+    EXPECT_EQ(ppc::mpi::GetHypercubeComm(comm, 0), pairs);
+    EXPECT_NE(ppc::mpi::GetHypercubeComm(comm, 1), pairs);
+
+    int size = 0;
+    MPI_Comm_size(comm, &size);
+    const std::array<int, 1> dims = {size};
+    const std::array<int, 1> periods = {1};
+    const std::array<int, 1> open = {0};
+    const MPI_Comm ring = ppc::mpi::GetCartComm(comm, dims, periods);
+    EXPECT_EQ(ppc::mpi::GetCartComm(comm, dims, periods), ring);
+    EXPECT_NE(ppc::mpi::GetCartComm(comm, dims, open), ring);
+    const std::array<int, 1> remain = {1};
+    EXPECT_EQ(ppc::mpi::GetCartSubComm(ring, remain), ppc::mpi::GetCartSubComm(ring, remain));
+    // Five communicators: two hypercube dimensions, two grids and one sub-grid
+    EXPECT_EQ(ppc::mpi::GetCommCacheSize(), before + 5);
+  });
+
+  const auto before = ppc::mpi::GetCommCacheSize();
+  const MPI_Datatype column = ppc::mpi::GetVectorType(4, 1, 8, MPI_DOUBLE, 8);
+  EXPECT_EQ(ppc::mpi::GetVectorType(4, 1, 8, MPI_DOUBLE, 8), column);
+  EXPECT_NE(ppc::mpi::GetVectorType(4, 1, 8, MPI_DOUBLE), column);
+  EXPECT_EQ(ppc::mpi::GetCommCacheSize(), before + 2);
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(column, &lower_bound, &extent);
+  EXPECT_EQ(extent, static_cast<MPI_Aint>(8 * sizeof(double)));
+}
+
+TEST_F(MpiRunCommCacheTest, CollectiveCommIsACachedDuplicate) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const auto before = ppc::mpi::GetCommCacheSize();
+    const MPI_Comm dup_comm = ppc::mpi::GetCollectiveComm(comm);
+    EXPECT_EQ(ppc::mpi::GetCollectiveComm(comm), dup_comm);
+    EXPECT_EQ(CompareComms(comm, dup_comm), MPI_CONGRUENT);
+    EXPECT_EQ(ppc::mpi::GetCommCacheSize(), before + 1);
+  });
+}
+
+TEST_F(MpiRunCommCacheTest, ScopesSubCommsToTheirParent) {
+  MPI_Comm first = MPI_COMM_NULL;
+  MPI_Comm second = MPI_COMM_NULL;
+  MPI_Comm_dup(MPI_COMM_WORLD, &first);
+  MPI_Comm_dup(MPI_COMM_WORLD, &second);
+  const auto before = ppc::mpi::GetCommCacheSize();
+
+  const MPI_Comm from_first = ppc::mpi::GetHypercubeComm(first, 0);
+  const MPI_Comm from_second = ppc::mpi::GetHypercubeComm(second, 0);
+  EXPECT_NE(from_first, from_second);
+  EXPECT_EQ(CompareComms(from_first, from_second), MPI_CONGRUENT);
+  EXPECT_EQ(ppc::mpi::GetCommCacheSize(), before + 2);
+
+  // Freeing a parent releases its sub-communicators and leaves the other parent's alone
+  MPI_Comm_free(&first);
+  EXPECT_EQ(ppc::mpi::GetCommCacheSize(), before + 1);
+  EXPECT_EQ(ppc::mpi::GetHypercubeComm(second, 0), from_second);
+  MPI_Comm_free(&second);
+  EXPECT_EQ(ppc::mpi::GetCommCacheSize(), before);
+}
+
+TEST_F(MpiRunCommCacheTest, ClearReleasesEverything) {
+  ppc::mpi::GetHypercubeComm(MPI_COMM_WORLD, 0);
+  ppc::mpi::GetVectorType(2, 1, 3, MPI_INT);
+  EXPECT_GE(ppc::mpi::GetCommCacheSize(), 2U);
+
+  ppc::mpi::ClearCommCache();
+  EXPECT_EQ(ppc::mpi::GetCommCacheSize(), 0U);
+  // A later lookup builds a fresh handle
+  EXPECT_NE(ppc::mpi::GetHypercubeComm(MPI_COMM_WORLD, 0), MPI_COMM_NULL);
+  EXPECT_EQ(ppc::mpi::GetCommCacheSize(), 1U);
+}
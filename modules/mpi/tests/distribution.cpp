@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#ifndef _WIN32
+#  include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+#include "mpi/include/distribution.hpp"
+#include "mpi/tests/mpi_run_test.hpp"
+
+namespace {
+
+template <ppc::mpi::Partition P>
+void ExpectConsistent(const P &partition) {
+  const auto &dist = partition.GetDistribution();
+  std::size_t total = 0;
+  for (int part = 0; part < partition.Parts(); part++) {
+    total += partition.LocalSize(part);
+    EXPECT_EQ(dist.counts[static_cast<std::size_t>(part)], partition.LocalSize(part));
+    for (std::size_t local = 0; local < partition.LocalSize(part); local++) {
+      const auto global = partition.ToGlobal(part, local);
+      ASSERT_LT(global, partition.Size());
+      EXPECT_EQ(partition.Owner(global), part);
+      EXPECT_EQ(partition.ToLocal(global), local);
+    }
+  }
+  EXPECT_EQ(total, partition.Size());
+  EXPECT_EQ(dist.Total(), partition.Size());
+}
+
+/// Not an arithmetic type, so it travels as sizeof(Item) MPI_BYTEs and counts are scaled by 16.
+struct Item {
+  std::int64_t index;
+  std::int64_t check;
+
+  bool operator==(const Item &) const = default;
+};
+
+Item MakeItem(std::size_t index) {
+  return {.index = static_cast<std::int64_t>(index), .check = ~static_cast<std::int64_t>(index)};
+}
+
+std::vector<Item> MakeItems(std::size_t count) {
+  std::vector<Item> items(count);
+  for (std::size_t i = 0; i < count; i++) {
+    items[i] = MakeItem(i);
+  }
+  return items;
+}
+
+/// Returns the number of elements of @p items that differ from MakeItem(first + i).
+std::size_t CountWrongItems(std::span<const Item> items, std::size_t first = 0) {
+  std::size_t wrong = 0;
+  for (std::size_t i = 0; i < items.size(); i++) {
+    wrong += items[i] == MakeItem(first + i) ? 0 : 1;
+  }
+  return wrong;
+}
+
+/// Physical memory currently free on the node, 0 where the platform does not report it.
+std::size_t FreeMemory() {
+#ifdef _SC_AVPHYS_PAGES
+  return static_cast<std::size_t>(sysconf(_SC_AVPHYS_PAGES)) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 0;
+#endif
+}
+
+int CommRank(MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  return rank;
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  return size;
+}
+
+class MpiRunDistributionTest : public ppc::mpi::test::MpiRunTest {};
+
+}  // namespace
+
+TEST(MpiDistributionTest, BlockDistributionSplitsRemainderOverFirstParts) {
+  const auto dist = ppc::mpi::BlockDistribution(10, 4);
+  EXPECT_EQ(dist.counts, (std::vector<std::size_t>{3, 3, 2, 2}));
+  EXPECT_EQ(dist.displs, (std::vector<std::size_t>{0, 3, 6, 8}));
+
+  const auto rows = ppc::mpi::BlockDistribution(5, 2, 4);
+  EXPECT_EQ(rows.counts, (std::vector<std::size_t>{12, 8}));
+  EXPECT_EQ(rows.displs, (std::vector<std::size_t>{0, 12}));
+  EXPECT_THROW(ppc::mpi::BlockDistribution(5, 0), std::invalid_argument);
+}
+
+TEST(MpiDistributionTest, DetectsCountsBeyondInt) {
+  const auto small = ppc::mpi::BlockDistribution(1000, 3);
+  EXPECT_TRUE(small.FitsInt());
+  EXPECT_TRUE(small.FitsInt(8));
+
+  const auto large = ppc::mpi::BlockDistribution(std::size_t{3} * INT_MAX, 2);
+  EXPECT_FALSE(large.FitsInt());
+  EXPECT_EQ(large.Total(), std::size_t{3} * INT_MAX);
+  EXPECT_FALSE(ppc::mpi::BlockDistribution(std::size_t{1} << 30, 1).FitsInt(4));
+}
+
+TEST(MpiDistributionTest, PartitionsMapIndicesBothWays) {
+  for (int parts : {1, 3, 4}) {
+    for (std::size_t size : {0U, 1U, 7U, 12U, 29U}) {
+      ExpectConsistent(ppc::mpi::BlockPartition(size, parts));
+      ExpectConsistent(ppc::mpi::CyclicPartition(size, parts));
+      ExpectConsistent(ppc::mpi::BlockCyclicPartition(size, parts, 3));
+    }
+  }
+}
+
+TEST(MpiDistributionTest, BlockCyclicDealsBlocksRoundRobin) {
+  const ppc::mpi::BlockCyclicPartition partition(10, 2, 3);
+  // Blocks [0,3) [3,6) [6,9) [9,10) go to parts 0, 1, 0, 1
+  EXPECT_EQ(partition.LocalSize(0), 6U);
+  EXPECT_EQ(partition.LocalSize(1), 4U);
+  EXPECT_EQ(partition.Owner(7), 0);
+  EXPECT_EQ(partition.ToLocal(7), 4U);
+  EXPECT_EQ(partition.ToGlobal(1, 3), 9U);
+  EXPECT_THROW(ppc::mpi::BlockCyclicPartition(10, 2, 0), std::invalid_argument);
+}
+
+TEST(MpiDistributionTest, PackGroupsElementsByOwner) {
+  const auto partition = ppc::mpi::CyclicPartition(7, 3);
+  std::vector<int> data(7);
+  std::iota(data.begin(), data.end(), 0);
+  std::vector<int> packed(7);
+  ppc::mpi::Pack(partition, std::span<const int>(data), std::span<int>(packed));
+  EXPECT_EQ(packed, (std::vector<int>{0, 3, 6, 1, 4, 2, 5}));
+
+  std::vector<int> unpacked(7);
+  ppc::mpi::Unpack(partition, std::span<const int>(packed), std::span<int>(unpacked));
+  EXPECT_EQ(unpacked, data);
+}
+
+TEST(MpiDistributionTest, MapsElementTypes) {
+  EXPECT_EQ(ppc::mpi::GetTypeInfo<double>().units, 1U);
+  EXPECT_EQ(ppc::mpi::GetTypeInfo<unsigned char>().bytes, 1U);
+
+  struct Point {
+    double x;
+    double y;
+  };
+  const auto info = ppc::mpi::GetTypeInfo<Point>();
+  EXPECT_EQ(info.units, sizeof(Point));
+  EXPECT_EQ(info.bytes, sizeof(Point));
+}
+
+TEST_F(MpiRunDistributionTest, BroadcastSizeKeepsSixtyFourBits) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = CommRank(comm);
+    for (int root = 0; root < CommSize(comm); root++) {
+      const std::size_t value = (std::size_t{1} << 40) + static_cast<std::size_t>(root);
+      EXPECT_EQ(ppc::mpi::BroadcastSize(rank == root ? value : 0, root, comm), value);
+    }
+  });
+}
+
+TEST_F(MpiRunDistributionTest, SegmentedTransfersMatchCollectives) {
+  const auto type = ppc::mpi::GetTypeInfo<Item>();
+  ppc::mpi::test::ForEachCommSize([&type](MPI_Comm comm) {
+    const int rank = CommRank(comm);
+    const auto size = static_cast<std::size_t>(CommSize(comm));
+    // Uneven parts, every third one empty
+    std::vector<std::size_t> counts(size);
+    for (std::size_t part = 0; part < size; part++) {
+      counts[part] = part % 3 == 1 ? 0 : part + 2;
+    }
+    const auto dist = ppc::mpi::MakeDistribution(counts);
+    const auto own = static_cast<std::size_t>(rank);
+    const auto global = MakeItems(dist.Total());
+
+    // A segment of 5 MPI_BYTEs ends inside an element; kMaxMessageCount takes the MPI_*v collectives
+    for (const std::size_t max_count : {std::size_t{5}, std::size_t{16}, ppc::mpi::kMaxMessageCount}) {
+      for (int root = 0; std::cmp_less(root, size); root++) {
+        std::vector<Item> local(dist.counts[own]);
+        ppc::mpi::detail::Scatterv(global.data(), local.data(), dist, type, root, comm, false, max_count);
+        EXPECT_EQ(CountWrongItems(local, dist.displs[own]), 0U) << "max_count " << max_count << ", root " << root;
+
+        std::vector<Item> gathered(rank == root ? global.size() : 0);
+        ppc::mpi::detail::Gatherv(local.data(), gathered.data(), dist, type, root, comm, false, max_count);
+        EXPECT_EQ(gathered, rank == root ? global : std::vector<Item>{});
+
+        // In place: every rank holds a full-size buffer and only its own part is filled
+        std::vector<Item> buffer(global.size());
+        if (rank == root) {
+          buffer = global;
+        }
+        ppc::mpi::detail::Scatterv(buffer.data(), buffer.data() + dist.displs[own], dist, type, root, comm, true,
+                                   max_count);
+        EXPECT_EQ(CountWrongItems(std::span<const Item>(buffer).subspan(dist.displs[own], dist.counts[own]),
+                                  dist.displs[own]),
+                  0U);
+        if (rank == root) {
+          std::ranges::fill(buffer, Item{});
+          std::ranges::copy(local, buffer.begin() + static_cast<std::ptrdiff_t>(dist.displs[own]));
+        }
+        ppc::mpi::detail::Gatherv(buffer.data() + dist.displs[own], buffer.data(), dist, type, root, comm, true,
+                                  max_count);
+        if (rank == root) {
+          EXPECT_EQ(buffer, global);
+        }
+      }
+
+      std::vector<Item> all(global.size());
+      ppc::mpi::detail::Allgatherv(global.data() + dist.displs[own], all.data(), dist, type, comm, false, max_count);
+      EXPECT_EQ(all, global) << "max_count " << max_count;
+
+      std::vector<Item> in_place(global.size());
+      std::copy_n(global.begin() + static_cast<std::ptrdiff_t>(dist.displs[own]), dist.counts[own],
+                  in_place.begin() + static_cast<std::ptrdiff_t>(dist.displs[own]));
+      ppc::mpi::detail::Allgatherv(nullptr, in_place.data(), dist, type, comm, true, max_count);
+      EXPECT_EQ(in_place, global) << "max_count " << max_count;
+    }
+  });
+}
+
+TEST_F(MpiRunDistributionTest, TransfersCountsAboveIntMax) {
+  // 16-byte elements go as MPI_BYTEs, so this element count is just above INT_MAX MPI items
+  constexpr std::size_t kItems = (static_cast<std::size_t>(INT_MAX) / sizeof(Item)) + 1;
+  constexpr std::size_t kBytes = kItems * sizeof(Item);
+  int world_size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+  if (world_size < 2) {
+    GTEST_SKIP() << "Needs two ranks";
+  }
+  // Ranks 0 and 1 hold the whole buffer each; every rank has to take the same decision
+  auto free_memory = static_cast<std::uint64_t>(FreeMemory());
+  MPI_Allreduce(MPI_IN_PLACE, &free_memory, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD);
+  if (free_memory < (2 * kBytes) + (std::size_t{1} << 30)) {
+    GTEST_SKIP() << "Needs " << ((2 * kBytes) >> 30) << " GiB of free memory";
+  }
+
+  const int world_rank = CommRank(MPI_COMM_WORLD);
+  MPI_Comm comm = MPI_COMM_NULL;
+  MPI_Comm_split(MPI_COMM_WORLD, world_rank < 2 ? 0 : MPI_UNDEFINED, world_rank, &comm);
+  if (comm == MPI_COMM_NULL) {
+    return;
+  }
+  // Rank 0 keeps an empty part and rank 1 gets everything, so one buffer per rank is enough
+  const auto dist = ppc::mpi::MakeDistribution({0, kItems});
+  ASSERT_FALSE(dist.FitsInt(ppc::mpi::GetTypeInfo<Item>().units));
+  const int rank = CommRank(comm);
+  std::vector<Item> buffer = rank == 0 ? MakeItems(kItems) : std::vector<Item>(kItems);
+
+  ppc::mpi::ScatterInPlace(std::span<Item>(buffer), dist, 0, comm);
+  if (rank == 1) {
+    EXPECT_EQ(CountWrongItems(buffer), 0U);
+  } else {
+    std::ranges::fill(buffer, Item{});
+  }
+  ppc::mpi::GatherInPlace(std::span<Item>(buffer), dist, 0, comm);
+  if (rank == 0) {
+    EXPECT_EQ(CountWrongItems(buffer), 0U);
+    std::ranges::fill(buffer, Item{});
+  }
+  ppc::mpi::AllgatherInPlace(std::span<Item>(buffer), dist, comm);
+  EXPECT_EQ(CountWrongItems(buffer), 0U);
+  MPI_Comm_free(&comm);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+namespace ppc::mpi::test {
+
+/// @brief Base of the tests that exchange messages.
+/// @details They run when core_func_tests is started under mpirun (run_tests.py selects them by the "MpiRun"
+/// suite prefix) and are skipped in the plain single-process run.
+class MpiRunTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized == 0) {
+      GTEST_SKIP() << "MPI is not initialized; run core_func_tests under mpirun";
+    }
+  }
+};
+
+/// @brief Calls fn(comm) on the first 1, 2, ..., world size ranks, so one launch covers odd and even comm sizes.
+template <typename Fn>
+void ForEachCommSize(Fn &&fn) {
+  int world_rank = 0;
+  int world_size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+  for (int size = 1; size <= world_size; size++) {
+    MPI_Comm comm = MPI_COMM_NULL;
+    MPI_Comm_split(MPI_COMM_WORLD, world_rank < size ? 0 : MPI_UNDEFINED, world_rank, &comm);
+    if (comm != MPI_COMM_NULL) {
+      fn(comm);
+      MPI_Comm_free(&comm);
+    }
+  }
+}
+
+}  // namespace ppc::mpi::test
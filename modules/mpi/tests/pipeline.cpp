@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+#include "mpi/include/distribution.hpp"
+#include "mpi/include/pipeline.hpp"
+#include "mpi/tests/mpi_run_test.hpp"
+
+namespace {
+
+class MpiRunPipelineTest : public ppc::mpi::test::MpiRunTest {};
+
+std::int64_t SumPiece(std::int64_t acc, std::span<const int> piece) {
+  return std::accumulate(piece.begin(), piece.end(), acc);
+}
+
+int MaxPiece(int acc, std::span<const int> piece) {
+  return piece.empty() ? acc : std::max(acc, std::ranges::max(piece));
+}
+
+std::int64_t SumBytes(std::int64_t acc, std::span<const unsigned char> piece) {
+  return std::accumulate(piece.begin(), piece.end(), acc);
+}
+
+unsigned char ByteAt(std::size_t index) {
+  return static_cast<unsigned char>((index * 31) + 7);
+}
+
+}  // namespace
+
+TEST(MpiPipelineTest, ChunksCoverEveryPartInOrder) {
+  const auto dist = ppc::mpi::BlockDistribution(23, 3);
+  constexpr std::size_t kChunks = 4;
+  for (std::size_t part = 0; part < 3; part++) {
+    std::size_t next = dist.displs[part];
+    for (std::size_t chunk = 0; chunk < kChunks; chunk++) {
+      const auto piece = ppc::mpi::ChunkDistribution(dist, chunk, kChunks);
+      EXPECT_EQ(piece.displs[part], next);
+      next += piece.counts[part];
+    }
+    EXPECT_EQ(next, dist.displs[part] + dist.counts[part]);
+  }
+}
+
+TEST(MpiPipelineTest, ChunkCountGrowsWithMessageSize) {
+  EXPECT_EQ(ppc::mpi::AutoPipelineChunks(0), 1U);
+  EXPECT_EQ(ppc::mpi::AutoPipelineChunks(ppc::mpi::kPipelineMinChunkBytes - 1), 1U);
+  EXPECT_EQ(ppc::mpi::AutoPipelineChunks(4 * ppc::mpi::kPipelineMinChunkBytes), 4U);
+  EXPECT_EQ(ppc::mpi::AutoPipelineChunks(std::size_t{1} << 40), ppc::mpi::kPipelineMaxChunks);
+
+  const auto small = ppc::mpi::BlockDistribution(1000, 2);
+  EXPECT_EQ(ppc::mpi::GetPipelineChunks(small, ppc::mpi::GetTypeInfo<int>()), 1U);
+}
+
+TEST(MpiPipelineTest, ChunksStayBelowMessageLimit) {
+  const auto huge = ppc::mpi::BlockDistribution(ppc::mpi::kMaxMessageCount * 40, 1);
+  EXPECT_GE(ppc::mpi::GetPipelineChunks(huge, ppc::mpi::GetTypeInfo<char>()), 40U);
+}
+
+TEST_F(MpiRunPipelineTest, MatchesSerialFold) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = ppc::mpi::detail::CommRank(comm);
+    int size = 0;
+    MPI_Comm_size(comm, &size);
+    const auto parts = static_cast<std::size_t>(size);
+    std::vector<int> data((parts * 101) + 3);
+    std::iota(data.begin(), data.end(), -50);
+    const auto expected_sum = std::accumulate(data.begin(), data.end(), std::int64_t{0});
+    const auto expected_max = std::ranges::max(data);
+
+    // The block split and one with an empty part and a remainder in every part
+    std::vector<std::size_t> counts(parts);
+    for (std::size_t part = 0; part + 1 < parts; part++) {
+      counts[part] = part == 0 ? 0 : (data.size() / parts) + 1;
+    }
+    counts.back() = data.size() - std::accumulate(counts.begin(), counts.end() - 1, std::size_t{0});
+    for (const auto &dist : {ppc::mpi::BlockDistribution(data.size(), size), ppc::mpi::MakeDistribution(counts)}) {
+      for (int root = 0; root < size; root++) {
+        const auto local = std::span<const int>(data).first(rank == root ? data.size() : 0);
+        for (const std::size_t chunks : {0U, 1U, 3U, 7U}) {
+          const auto sum =
+              ppc::mpi::PipelinedScatterReduce(local, dist, std::int64_t{0}, SumPiece, MPI_SUM, root, comm, chunks);
+          EXPECT_EQ(sum, expected_sum) << "chunks " << chunks << ", root " << root;
+          const auto max =
+              ppc::mpi::PipelinedScatterReduce(local, dist, INT_MIN, MaxPiece, MPI_MAX, root, comm, chunks);
+          EXPECT_EQ(max, expected_max);
+        }
+      }
+    }
+  });
+}
+
+TEST_F(MpiRunPipelineTest, ScattersChunksBeyondIntDisplacements) {
+  // The root buffer is allocated but only the parts are written, so the pages beyond them stay untouched
+  static constexpr std::size_t kPart = 5000;
+  static constexpr auto kFar = static_cast<std::size_t>(INT_MAX) + 1000;
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = ppc::mpi::detail::CommRank(comm);
+    int size = 0;
+    MPI_Comm_size(comm, &size);
+    const auto parts = static_cast<std::size_t>(size);
+    // All parts far into the buffer (one rebased MPI_Iscatterv per chunk), and part 0 at the front with the
+    // others far away (point to point)
+    ppc::mpi::Distribution far{.counts = std::vector<std::size_t>(parts, kPart), .displs = {}};
+    ppc::mpi::Distribution apart = far;
+    for (std::size_t part = 0; part < parts; part++) {
+      far.displs.push_back(kFar + (part * kPart));
+      apart.displs.push_back(part == 0 ? 0 : kFar + (part * kPart));
+    }
+    for (const auto &dist : {far, apart}) {
+      std::unique_ptr<unsigned char[]> buffer;
+      std::span<const unsigned char> data;
+      std::int64_t expected = 0;
+      for (std::size_t part = 0; part < parts; part++) {
+        for (std::size_t i = dist.displs[part]; i < dist.displs[part] + kPart; i++) {
+          expected += ByteAt(i);
+        }
+      }
+      if (rank == 0) {
+        buffer = std::make_unique_for_overwrite<unsigned char[]>(dist.Total());
+        for (std::size_t part = 0; part < parts; part++) {
+          for (std::size_t i = dist.displs[part]; i < dist.displs[part] + kPart; i++) {
+            buffer[i] = ByteAt(i);
+          }
+        }
+        data = std::span<const unsigned char>(buffer.get(), dist.Total());
+      }
+      EXPECT_EQ(ppc::mpi::PipelinedScatterReduce(data, dist, std::int64_t{0}, SumBytes, MPI_SUM, 0, comm, 3), expected);
+    }
+  });
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "mpi/include/comm_cache.hpp"
+#include "mpi/include/distribution.hpp"
+#include "mpi/include/shared_memory.hpp"
+#include "mpi/tests/mpi_run_test.hpp"
+
+namespace {
+
+class MpiRunSharedMemoryTest : public ppc::mpi::test::MpiRunTest {};
+
+int CommSize(MPI_Comm comm) {
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  return size;
+}
+
+}  // namespace
+
+TEST(MpiSharedMemoryTest, LocalPartOwnsOrViews) {
+  const std::vector<int> data = {1, 2, 3, 4};
+
+  ppc::mpi::LocalPart<int> owned{std::vector<int>(data)};
+  const ppc::mpi::LocalPart<int> moved = std::move(owned);
+  EXPECT_FALSE(moved.IsShared());
+  EXPECT_EQ(std::vector<int>(moved.Get().begin(), moved.Get().end()), data);
+
+  const ppc::mpi::LocalPart<int> view(std::span<const int>(data).subspan(1, 2));
+  EXPECT_TRUE(view.IsShared());
+  EXPECT_EQ(view.Get().data(), data.data() + 1);
+  EXPECT_EQ(view.Get().size(), 2U);
+}
+
+TEST_F(MpiRunSharedMemoryTest, OwnerWritesAreVisibleToAllRanks) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = ppc::mpi::detail::CommRank(comm);
+    const int size = CommSize(comm);
+    if (!ppc::mpi::IsSharedMemoryComm(comm)) {
+      EXPECT_EQ(ppc::mpi::SharedWindow::Create(comm, 0, 16), nullptr);
+      return;
+    }
+    for (int owner = 0; owner < size; owner++) {
+      const auto window = ppc::mpi::SharedWindow::Create(comm, owner, static_cast<std::size_t>(size) * sizeof(int));
+      ASSERT_NE(window, nullptr);
+      auto *values = reinterpret_cast<int *>(window->Data());
+      if (rank == owner) {
+        std::iota(values, values + size, owner);
+      }
+      window->Publish();
+      EXPECT_EQ(values[rank], owner + rank);
+    }
+  });
+}
+
+TEST_F(MpiRunSharedMemoryTest, KeepsWindowAndNodeCommAcrossCalls) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const MPI_Comm node_comm = ppc::mpi::GetSharedComm(comm);
+    if (node_comm == MPI_COMM_NULL) {
+      return;
+    }
+    EXPECT_EQ(ppc::mpi::GetSharedComm(comm), node_comm);
+    const auto cached = ppc::mpi::GetCommCacheSize();
+    auto *window = ppc::mpi::SharedWindow::GetCached(comm, 0, 256);
+    EXPECT_EQ(ppc::mpi::SharedWindow::GetCached(comm, 0, 128), window);
+    EXPECT_TRUE(ppc::mpi::IsSharedMemoryComm(comm));
+    EXPECT_EQ(ppc::mpi::GetCommCacheSize(), cached);
+  });
+}
+
+TEST_F(MpiRunSharedMemoryTest, ScatterViewSharesOnlyTheOtherRanksParts) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int size = CommSize(comm);
+    if (size == 1 || !ppc::mpi::IsSharedMemoryComm(comm)) {
+      return;
+    }
+    const auto dist = ppc::mpi::BlockDistribution(101, size);
+    const int root = size - 1;
+    std::vector<int> data(dist.Total());
+    std::iota(data.begin(), data.end(), 0);
+    (void)ppc::mpi::ScatterView(std::span<const int>(data), dist, root, comm);
+    const auto *window = ppc::mpi::SharedWindow::GetCached(comm, root, 0);
+    ASSERT_NE(window, nullptr);
+    EXPECT_EQ(window->Size(), (dist.Total() - dist.counts[static_cast<std::size_t>(root)]) * sizeof(int));
+  });
+}
+
+TEST_F(MpiRunSharedMemoryTest, ScatterViewMatchesScatter) {
+  ppc::mpi::test::ForEachCommSize([](MPI_Comm comm) {
+    const int rank = ppc::mpi::detail::CommRank(comm);
+    const int size = CommSize(comm);
+    const auto own = static_cast<std::size_t>(rank);
+    const bool shared = ppc::mpi::IsSharedMemoryComm(comm);
+    std::vector<std::size_t> counts(static_cast<std::size_t>(size));
+    for (std::size_t part = 0; part < counts.size(); part++) {
+      counts[part] = part % 2 == 1 ? 0 : (part * 3) + 5;
+    }
+    // Later calls reuse the window with new data, a bigger distribution grows it
+    for (const auto &dist : {ppc::mpi::BlockDistribution(50, size), ppc::mpi::MakeDistribution(counts),
+                             ppc::mpi::BlockDistribution(1000, size)}) {
+      for (int root = 0; root < size; root++) {
+        std::vector<int> data(dist.Total());
+        std::iota(data.begin(), data.end(), root * 10000);
+        const auto part = ppc::mpi::ScatterView(std::span<const int>(data), dist, root, comm);
+        const auto expected = std::span<const int>(data).subspan(dist.displs[own], dist.counts[own]);
+        EXPECT_TRUE(std::ranges::equal(part.Get(), expected)) << "root " << root;
+        EXPECT_EQ(part.IsShared(), shared || size == 1);
+      }
+    }
+  });
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+/// @brief PMPI-based communication profiler.
+/// @details The library defines the MPI_* entry points listed in Function and forwards them to PMPI_*,
+/// counting calls, payload bytes and time spent in each function on the calling rank.
+/// Counting happens only between Start() and Stop(), so runner and harness traffic is not included.
+namespace ppc::mpi_profiler {
+
+/// @brief MPI functions intercepted by the profiler.
+enum class Function : uint8_t {
+  kSend,
+  kRecv,
+  kIsend,
+  kIrecv,
+  kSendrecv,
+  kWait,
+  kWaitall,
+  kProbe,
+  kBarrier,
+  kBcast,
+  kReduce,
+  kAllreduce,
+  kScatter,
+  kScatterv,
+  kIscatterv,
+  kGather,
+  kGatherv,
+  kAllgather,
+  kAllgatherv,
+  kAlltoall,
+  kAlltoallv,
+  kCommSplit,
+  kCommFree,
+  kCount,
+};
+
+inline constexpr std::size_t kNumFunctions = static_cast<std::size_t>(Function::kCount);
+
+/// @brief Statistics of one MPI function on one rank.
+struct CallStats {
+  uint64_t calls = 0;
+  /// @brief Payload bytes handled by the calling rank (sent and/or received buffers).
+  uint64_t bytes = 0;
+  double time_sec = 0.0;
+};
+
+using Profile = std::array<CallStats, kNumFunctions>;
+
+/// @brief Returns the MPI name of the function, e.g. "MPI_Send".
+std::string_view GetFunctionName(Function function);
+
+/// @brief Clears all counters and starts counting.
+void Start();
+
+/// @brief Stops counting; counters keep their values until the next Start().
+void Stop();
+
+/// @brief Returns true between Start() and Stop().
+bool IsActive();
+
+/// @brief Returns the counters of the calling rank.
+Profile GetLocalProfile();
+
+/// @brief Collects the counters of every rank of MPI_COMM_WORLD on rank 0.
+/// @details Collective call. Uses PMPI directly, so it does not show up in the profile.
+/// @return Profiles indexed by rank on rank 0, an empty vector on other ranks.
+std::vector<Profile> GatherProfiles();
+
+/// @brief Converts per-rank profiles to JSON, skipping functions that were never called.
+nlohmann::json ProfilesToJson(const std::vector<Profile> &profiles);
+
+/// @brief Formats one line per called function with totals over ranks and the slowest rank's time.
+std::string FormatProfiles(const std::string &prefix, const std::vector<Profile> &profiles);
+
+}  // namespace ppc::mpi_profiler
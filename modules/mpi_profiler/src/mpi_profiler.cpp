@@ -0,0 +1,351 @@
+#include "mpi_profiler/include/mpi_profiler.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace ppc::mpi_profiler {
+
+namespace {
+
+constexpr std::array<std::string_view, kNumFunctions> kFunctionNames = {
+    "MPI_Send",   "MPI_Recv",     "MPI_Isend",  "MPI_Irecv",   "MPI_Sendrecv",  "MPI_Wait",
+    "MPI_Waitall", "MPI_Probe",   "MPI_Barrier", "MPI_Bcast",  "MPI_Reduce",    "MPI_Allreduce",
+    "MPI_Scatter", "MPI_Scatterv", "MPI_Iscatterv", "MPI_Gather", "MPI_Gatherv", "MPI_Allgather",
+    "MPI_Allgatherv", "MPI_Alltoall", "MPI_Alltoallv", "MPI_Comm_split", "MPI_Comm_free"};
+
+struct Counters {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> time_ns{0};
+};
+
+std::atomic<bool> active{false};
+std::array<Counters, kNumFunctions> counters;
+
+/// Records one call of the function when it goes out of scope.
+class CallScope {
+ public:
+  CallScope(Function function, uint64_t bytes) : function_(function), bytes_(bytes), begin_(PMPI_Wtime()) {}
+  CallScope(const CallScope &) = delete;
+  CallScope &operator=(const CallScope &) = delete;
+  ~CallScope() {
+    if (!active.load(std::memory_order_relaxed)) {
+      return;
+    }
+    auto &entry = counters[static_cast<std::size_t>(function_)];
+    entry.calls.fetch_add(1, std::memory_order_relaxed);
+    entry.bytes.fetch_add(bytes_, std::memory_order_relaxed);
+    entry.time_ns.fetch_add(static_cast<uint64_t>((PMPI_Wtime() - begin_) * 1e9), std::memory_order_relaxed);
+  }
+
+ private:
+  Function function_;
+  uint64_t bytes_;
+  double begin_;
+};
+
+uint64_t PayloadBytes(int count, MPI_Datatype datatype) {
+  if (!active.load(std::memory_order_relaxed) || count <= 0 || datatype == MPI_DATATYPE_NULL) {
+    return 0;
+  }
+  int type_size = 0;
+  PMPI_Type_size(datatype, &type_size);
+  return static_cast<uint64_t>(count) * static_cast<uint64_t>(type_size);
+}
+
+uint64_t PayloadBytes(const int counts[], MPI_Comm comm, MPI_Datatype datatype) {
+  if (!active.load(std::memory_order_relaxed) || counts == nullptr) {
+    return 0;
+  }
+  int size = 0;
+  PMPI_Comm_size(comm, &size);
+  uint64_t total = 0;
+  for (int i = 0; i < size; i++) {
+    total += PayloadBytes(counts[i], datatype);
+  }
+  return total;
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 1;
+  PMPI_Comm_size(comm, &size);
+  return size;
+}
+
+bool IsRoot(int root, MPI_Comm comm) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+}  // namespace
+
+std::string_view GetFunctionName(Function function) {
+  const auto index = static_cast<std::size_t>(function);
+  return index < kNumFunctions ? kFunctionNames[index] : std::string_view("unknown");
+}
+
+void Start() {
+  for (auto &entry : counters) {
+    entry.calls.store(0);
+    entry.bytes.store(0);
+    entry.time_ns.store(0);
+  }
+  active.store(true);
+}
+
+void Stop() {
+  active.store(false);
+}
+
+bool IsActive() {
+  return active.load();
+}
+
+Profile GetLocalProfile() {
+  Profile profile;
+  for (std::size_t i = 0; i < kNumFunctions; i++) {
+    profile[i].calls = counters[i].calls.load();
+    profile[i].bytes = counters[i].bytes.load();
+    profile[i].time_sec = static_cast<double>(counters[i].time_ns.load()) * 1e-9;
+  }
+  return profile;
+}
+
+std::vector<Profile> GatherProfiles() {
+  constexpr int kFieldsPerFunction = 3;
+  constexpr int kLocalCount = static_cast<int>(kNumFunctions) * kFieldsPerFunction;
+  std::array<uint64_t, static_cast<std::size_t>(kLocalCount)> local{};
+  for (std::size_t i = 0; i < kNumFunctions; i++) {
+    local[(i * kFieldsPerFunction) + 0] = counters[i].calls.load();
+    local[(i * kFieldsPerFunction) + 1] = counters[i].bytes.load();
+    local[(i * kFieldsPerFunction) + 2] = counters[i].time_ns.load();
+  }
+
+  int rank = 0;
+  int size = 1;
+  PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  PMPI_Comm_size(MPI_COMM_WORLD, &size);
+  std::vector<uint64_t> all(rank == 0 ? static_cast<std::size_t>(size) * local.size() : 0);
+  PMPI_Gather(local.data(), kLocalCount, MPI_UINT64_T, all.data(), kLocalCount, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+  std::vector<Profile> profiles(rank == 0 ? static_cast<std::size_t>(size) : 0);
+  for (std::size_t proc = 0; proc < profiles.size(); proc++) {
+    const auto *values = all.data() + (proc * local.size());
+    for (std::size_t i = 0; i < kNumFunctions; i++) {
+      profiles[proc][i].calls = values[(i * kFieldsPerFunction) + 0];
+      profiles[proc][i].bytes = values[(i * kFieldsPerFunction) + 1];
+      profiles[proc][i].time_sec = static_cast<double>(values[(i * kFieldsPerFunction) + 2]) * 1e-9;
+    }
+  }
+  return profiles;
+}
+
+nlohmann::json ProfilesToJson(const std::vector<Profile> &profiles) {
+  auto result = nlohmann::json::array();
+  for (const auto &profile : profiles) {
+    auto rank_json = nlohmann::json::object();
+    for (std::size_t i = 0; i < kNumFunctions; i++) {
+      if (profile[i].calls == 0) {
+        continue;
+      }
+      rank_json[std::string(kFunctionNames[i])] = {
+          {"calls", profile[i].calls}, {"bytes", profile[i].bytes}, {"time_sec", profile[i].time_sec}};
+    }
+    result.push_back(rank_json);
+  }
+  return result;
+}
+
+std::string FormatProfiles(const std::string &prefix, const std::vector<Profile> &profiles) {
+  std::stringstream out;
+  out << std::fixed << std::setprecision(10);
+  for (std::size_t i = 0; i < kNumFunctions; i++) {
+    CallStats total;
+    double max_time = 0.0;
+    for (const auto &profile : profiles) {
+      total.calls += profile[i].calls;
+      total.bytes += profile[i].bytes;
+      total.time_sec += profile[i].time_sec;
+      max_time = std::max(max_time, profile[i].time_sec);
+    }
+    if (total.calls == 0) {
+      continue;
+    }
+    out << prefix << ":mpi " << kFunctionNames[i] << " calls=" << total.calls << " bytes=" << total.bytes
+        << " time=" << total.time_sec << " max_rank_time=" << max_time << '\n';
+  }
+  return out.str();
+}
+
+}  // namespace ppc::mpi_profiler
+
+using ppc::mpi_profiler::CallScope;
+using ppc::mpi_profiler::Function;
+
+// NOLINTBEGIN(readability-identifier-naming,readability-inconsistent-declaration-parameter-name)
+extern "C" {
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  const CallScope scope(Function::kSend, ppc::mpi_profiler::PayloadBytes(count, datatype));
+  return PMPI_Send(buf, count, datatype, dest, tag, comm);
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  const CallScope scope(Function::kRecv, ppc::mpi_profiler::PayloadBytes(count, datatype));
+  return PMPI_Recv(buf, count, datatype, source, tag, comm, status);
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  const CallScope scope(Function::kIsend, ppc::mpi_profiler::PayloadBytes(count, datatype));
+  return PMPI_Isend(buf, count, datatype, dest, tag, comm, request);
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  const CallScope scope(Function::kIrecv, ppc::mpi_profiler::PayloadBytes(count, datatype));
+  return PMPI_Irecv(buf, count, datatype, source, tag, comm, request);
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  const CallScope scope(Function::kSendrecv, ppc::mpi_profiler::PayloadBytes(sendcount, sendtype) +
+                                                 ppc::mpi_profiler::PayloadBytes(recvcount, recvtype));
+  return PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source, recvtag,
+                       comm, status);
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+  const CallScope scope(Function::kWait, 0);
+  return PMPI_Wait(request, status);
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status array_of_statuses[]) {
+  const CallScope scope(Function::kWaitall, 0);
+  return PMPI_Waitall(count, array_of_requests, array_of_statuses);
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  const CallScope scope(Function::kProbe, 0);
+  return PMPI_Probe(source, tag, comm, status);
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+  const CallScope scope(Function::kBarrier, 0);
+  return PMPI_Barrier(comm);
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  const CallScope scope(Function::kBcast, ppc::mpi_profiler::PayloadBytes(count, datatype));
+  return PMPI_Bcast(buffer, count, datatype, root, comm);
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  const CallScope scope(Function::kReduce, ppc::mpi_profiler::PayloadBytes(count, datatype));
+  return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm);
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  const CallScope scope(Function::kAllreduce, ppc::mpi_profiler::PayloadBytes(count, datatype));
+  return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = ppc::mpi_profiler::IsRoot(root, comm);
+  const uint64_t bytes = is_root ? ppc::mpi_profiler::PayloadBytes(sendcount, sendtype) *
+                                       static_cast<uint64_t>(ppc::mpi_profiler::CommSize(comm))
+                                 : ppc::mpi_profiler::PayloadBytes(recvcount, recvtype);
+  const CallScope scope(Function::kScatter, bytes);
+  return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                 void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = ppc::mpi_profiler::IsRoot(root, comm);
+  const uint64_t bytes = is_root ? ppc::mpi_profiler::PayloadBytes(sendcounts, comm, sendtype)
+                                 : ppc::mpi_profiler::PayloadBytes(recvcount, recvtype);
+  const CallScope scope(Function::kScatterv, bytes);
+  return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Iscatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                  void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  const bool is_root = ppc::mpi_profiler::IsRoot(root, comm);
+  const uint64_t bytes = is_root ? ppc::mpi_profiler::PayloadBytes(sendcounts, comm, sendtype)
+                                 : ppc::mpi_profiler::PayloadBytes(recvcount, recvtype);
+  const CallScope scope(Function::kIscatterv, bytes);
+  return PMPI_Iscatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm, request);
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = ppc::mpi_profiler::IsRoot(root, comm);
+  const uint64_t bytes = is_root ? ppc::mpi_profiler::PayloadBytes(recvcount, recvtype) *
+                                       static_cast<uint64_t>(ppc::mpi_profiler::CommSize(comm))
+                                 : ppc::mpi_profiler::PayloadBytes(sendcount, sendtype);
+  const CallScope scope(Function::kGather, bytes);
+  return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = ppc::mpi_profiler::IsRoot(root, comm);
+  const uint64_t bytes = is_root ? ppc::mpi_profiler::PayloadBytes(recvcounts, comm, recvtype)
+                                 : ppc::mpi_profiler::PayloadBytes(sendcount, sendtype);
+  const CallScope scope(Function::kGatherv, bytes);
+  return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  const CallScope scope(Function::kAllgather, ppc::mpi_profiler::PayloadBytes(recvcount, recvtype) *
+                                                  static_cast<uint64_t>(ppc::mpi_profiler::CommSize(comm)));
+  return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const CallScope scope(Function::kAllgatherv, ppc::mpi_profiler::PayloadBytes(recvcounts, comm, recvtype));
+  return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+  const CallScope scope(Function::kAlltoall, ppc::mpi_profiler::PayloadBytes(sendcount, sendtype) *
+                                                 static_cast<uint64_t>(ppc::mpi_profiler::CommSize(comm)));
+  return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                  void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const CallScope scope(Function::kAlltoallv, ppc::mpi_profiler::PayloadBytes(sendcounts, comm, sendtype));
+  return PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+}
+
+int MPI_Comm_split(MPI_Comm comm, int color, int key, MPI_Comm *newcomm) {
+  const CallScope scope(Function::kCommSplit, 0);
+  return PMPI_Comm_split(comm, color, key, newcomm);
+}
+
+int MPI_Comm_free(MPI_Comm *comm) {
+  const CallScope scope(Function::kCommFree, 0);
+  return PMPI_Comm_free(comm);
+}
+
+}  // extern "C"
+// NOLINTEND(readability-identifier-naming,readability-inconsistent-declaration-parameter-name)
@@ -0,0 +1,105 @@
+#include "mpi_profiler/include/mpi_profiler.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mpi/tests/mpi_run_test.hpp"
+#include "runners/include/runners.hpp"
+#include "util/include/util.hpp"
+
+namespace profiler = ppc::mpi_profiler;
+
+namespace {
+
+class MpiRunProfilerTest : public ppc::mpi::test::MpiRunTest {};
+
+constexpr int kPayloadCount = 100;
+constexpr uint64_t kPayloadBytes = kPayloadCount * sizeof(double);
+
+const profiler::CallStats &StatsOf(const profiler::Profile &profile, profiler::Function function) {
+  return profile[static_cast<std::size_t>(function)];
+}
+
+uint64_t TotalCalls(const profiler::Profile &profile) {
+  uint64_t calls = 0;
+  for (const auto &stats : profile) {
+    calls += stats.calls;
+  }
+  return calls;
+}
+
+/// Rank 0 sends kPayloadCount doubles to rank 1; the other ranks make no call.
+void SendPayload(int rank) {
+  std::vector<double> payload(kPayloadCount, 1.5);
+  if (rank == 0) {
+    MPI_Send(payload.data(), kPayloadCount, MPI_DOUBLE, 1, 0, MPI_COMM_WORLD);
+  } else if (rank == 1) {
+    MPI_Recv(payload.data(), kPayloadCount, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  }
+}
+
+}  // namespace
+
+TEST(MpiProfilerTest, FormatsOnlyCalledFunctions) {
+  profiler::Profile profile{};
+  profile[static_cast<std::size_t>(profiler::Function::kSend)] = {.calls = 2, .bytes = 64, .time_sec = 0.5};
+  const std::vector<profiler::Profile> profiles = {profile, profiler::Profile{}};
+  EXPECT_EQ(profiler::GetFunctionName(profiler::Function::kSend), "MPI_Send");
+  EXPECT_EQ(profiler::FormatProfiles("task", profiles),
+            "task:mpi MPI_Send calls=2 bytes=64 time=0.5000000000 max_rank_time=0.5000000000\n");
+  const auto json = profiler::ProfilesToJson(profiles);
+  ASSERT_EQ(json.size(), 2U);
+  EXPECT_EQ(json[0]["MPI_Send"]["calls"], 2);
+  EXPECT_TRUE(json[1].empty());
+}
+
+TEST_F(MpiRunProfilerTest, CountsKnownSendRecvPair) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  if (size < 2) {
+    GTEST_SKIP() << "Needs at least two ranks";
+  }
+
+  profiler::Start();
+  SendPayload(rank);
+  profiler::Stop();
+  // Calls after Stop() leave the counters alone
+  SendPayload(rank);
+
+  const auto profile = profiler::GetLocalProfile();
+  const auto &send = StatsOf(profile, profiler::Function::kSend);
+  const auto &recv = StatsOf(profile, profiler::Function::kRecv);
+  if (rank == 0) {
+    EXPECT_EQ(send.calls, 1U);
+    EXPECT_EQ(send.bytes, kPayloadBytes);
+    EXPECT_EQ(TotalCalls(profile), 1U);
+  } else if (rank == 1) {
+    EXPECT_EQ(recv.calls, 1U);
+    EXPECT_EQ(recv.bytes, kPayloadBytes);
+    EXPECT_EQ(TotalCalls(profile), 1U);
+  } else {
+    EXPECT_EQ(TotalCalls(profile), 0U);
+  }
+
+  // The gather goes through PMPI, so it does not add an MPI_Gather to the profiles it collects
+  const auto profiles = profiler::GatherProfiles();
+  if (rank == 0) {
+    ASSERT_EQ(profiles.size(), static_cast<std::size_t>(size));
+    EXPECT_EQ(StatsOf(profiles[0], profiler::Function::kSend).bytes, kPayloadBytes);
+    EXPECT_EQ(StatsOf(profiles[1], profiler::Function::kRecv).bytes, kPayloadBytes);
+    EXPECT_EQ(StatsOf(profiles[0], profiler::Function::kGather).calls, 0U);
+  }
+}
+
+int main(int argc, char **argv) {
+  if (ppc::util::IsUnderMpirun()) {
+    return ppc::runners::Init(argc, argv);
+  }
+  return ppc::runners::SimpleInit(argc, argv);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+/// @brief Heap allocation counters of the calling rank.
+/// @details When built with -D USE_ALLOC_TRACKER=ON, ppc_perf_tests replaces the global operator new/delete
+/// and reports every call here. Counting happens only between Start() and Stop(), so harness allocations
+/// (input generation, result checks) are not included.
+namespace ppc::performance::alloc_tracker {
+
+/// @brief Heap statistics of one rank.
+struct AllocStats {
+  uint64_t allocations = 0;
+  uint64_t deallocations = 0;
+  /// @brief Bytes requested by the allocations.
+  uint64_t bytes = 0;
+  /// @brief Peak resident set size between Start() and Stop() in KiB; 0 if the system does not report it.
+  /// @details Linux resets the high-water mark on Start(); elsewhere this is the peak of the whole process.
+  uint64_t peak_rss_kib = 0;
+};
+
+/// @brief Clears the counters, resets the RSS high-water mark where possible and starts counting.
+void Start();
+
+/// @brief Stops counting and samples the peak RSS; counters keep their values until the next Start().
+void Stop();
+
+/// @brief Stops counting without sampling the peak RSS; Resume() continues with the current counters.
+void Pause();
+
+/// @brief Continues counting after Pause().
+void Resume();
+
+/// @brief Returns true between Start() and Stop(), except while paused.
+bool IsActive();
+
+/// @brief Called by the replaced operator new; must not allocate.
+void RecordAllocation(std::size_t size) noexcept;
+
+/// @brief Called by the replaced operator delete; must not allocate.
+void RecordDeallocation() noexcept;
+
+/// @brief Returns the counters of the calling rank.
+AllocStats GetLocalStats();
+
+/// @brief Collects the counters of every rank of MPI_COMM_WORLD on rank 0.
+/// @details Collective call when MPI is initialized; otherwise returns the local counters.
+/// @return Stats indexed by rank on rank 0, an empty vector on other ranks.
+std::vector<AllocStats> GatherStats();
+
+/// @brief Converts per-rank stats to JSON.
+nlohmann::json StatsToJson(const std::vector<AllocStats> &stats);
+
+/// @brief Formats one line with totals over ranks and the largest per-rank peak RSS.
+std::string FormatStats(const std::string &prefix, const std::vector<AllocStats> &stats);
+
+}  // namespace ppc::performance::alloc_tracker
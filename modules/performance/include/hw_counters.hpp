@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Hardware events sampled around the measured code.
+enum class HwCounter : uint8_t {
+  kCycles,
+  kInstructions,
+  kLlcMisses,
+  kBranchMisses,
+  kCount,
+};
+
+inline constexpr std::size_t kNumHwCounters = static_cast<std::size_t>(HwCounter::kCount);
+
+/// @brief Counter values; std::nullopt marks an event the system does not let us count.
+using HwCounterValues = std::array<std::optional<uint64_t>, kNumHwCounters>;
+
+/// @brief Returns a short name of the event, e.g. "cycles".
+std::string_view GetHwCounterName(HwCounter counter);
+
+/// @brief Set of hardware counters for all threads of the calling process.
+/// @details Uses Linux perf_event_open with user-space-only events, opened once per thread listed in
+/// /proc/self/task when the group is created, so OpenMP and TBB pools started earlier are counted too;
+/// threads created later are followed through inherit. Read() sums over the threads. Events that cannot be
+/// opened (no PMU, restrictive perf_event_paranoid, seccomp in containers, non-Linux systems) stay
+/// unavailable instead of failing the measurement.
+class HwCounterGroup {
+ public:
+  HwCounterGroup();
+  HwCounterGroup(const HwCounterGroup &) = delete;
+  HwCounterGroup &operator=(const HwCounterGroup &) = delete;
+  ~HwCounterGroup();
+
+  /// @brief Returns true if at least one event could be opened.
+  [[nodiscard]] bool IsAvailable() const;
+
+  /// @brief Returns the number of threads at least one event was opened for.
+  [[nodiscard]] std::size_t GetNumThreads() const;
+
+  /// @brief Resets and enables all available events.
+  void Start();
+
+  /// @brief Disables all available events.
+  void Stop();
+
+  /// @brief Enables all available events again without resetting them, to count several disjoint windows.
+  void Resume();
+
+  /// @brief Reads the events accumulated since the last Start().
+  [[nodiscard]] HwCounterValues Read() const;
+
+ private:
+  /// @brief Per counter, one descriptor per counted thread.
+  std::array<std::vector<int>, kNumHwCounters> fds_;
+  std::size_t num_threads_ = 0;
+};
+
+}  // namespace ppc::performance
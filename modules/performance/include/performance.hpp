@@ -1,15 +1,31 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
+#include "performance/include/alloc_tracker.hpp"
+#include "performance/include/hw_counters.hpp"
 #include "task/include/task.hpp"
+#include "util/include/placement.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::performance {
@@ -18,18 +34,154 @@ inline double DefaultTimer() {
   return -1.0;
 }
 
+inline bool DefaultStopConsensus(bool local_stop) {
+  return local_stop;
+}
+
+/// @brief Strategy used to choose the number of timed iterations.
+enum class IterationPolicy : uint8_t {
+  /// Run exactly num_running iterations
+  kFixed,
+  /// Run until the median confidence interval is narrow enough or the time budget is exhausted
+  kAdaptive,
+};
+
 struct PerfAttr {
   /// @brief Number of times the task is run for performance evaluation.
   uint64_t num_running = 5;
+  /// @brief Number of untimed runs executed before measurement starts.
+  uint64_t num_warmup = 0;
+  /// @brief Iteration policy; kAdaptive ignores num_running.
+  IterationPolicy iteration_policy = IterationPolicy::kFixed;
+  /// @brief Minimum number of timed iterations in adaptive mode.
+  uint64_t min_running = 5;
+  /// @brief Maximum number of timed iterations in adaptive mode.
+  uint64_t max_running = 1000;
+  /// @brief Target relative half-width of the 95% confidence interval of the median in adaptive mode.
+  double target_relative_ci = 0.02;
+  /// @brief Wall-clock budget for timed iterations in adaptive mode; non-positive means GetPerfMaxTime().
+  double time_budget_sec = 0.0;
+  /// @brief Sample hardware counters (cycles, instructions, LLC and branch misses) over the timed iterations.
+  bool collect_hw_counters = false;
+  /// @brief Count heap allocations of the timed iterations with alloc_tracker (needs USE_ALLOC_TRACKER).
+  bool track_allocations = false;
   /// @brief Timer function returning current time in seconds.
   /// @cond
   std::function<double()> current_timer = DefaultTimer;
   /// @endcond
+  /// @brief Combines the local stop decision of adaptive mode across processes.
+  /// @details Must return the same value on every process, e.g. by broadcasting the decision of rank 0.
+  /// @cond
+  std::function<bool(bool)> stop_consensus = DefaultStopConsensus;
+  /// @endcond
+};
+
+/// @brief Summary statistics over per-iteration time samples.
+struct PerfStatistics {
+  double min_sec = 0.0;
+  double median_sec = 0.0;
+  double mean_sec = 0.0;
+  double p90_sec = 0.0;
+  double p99_sec = 0.0;
+  double stddev_sec = 0.0;
+};
+
+/// @brief Returns the q-quantile (0 <= q <= 1) of sorted samples using linear interpolation.
+inline double GetQuantile(const std::vector<double> &sorted_samples, double q) {
+  if (sorted_samples.empty()) {
+    return 0.0;
+  }
+  const double pos = std::clamp(q, 0.0, 1.0) * static_cast<double>(sorted_samples.size() - 1);
+  const auto lo = static_cast<std::size_t>(std::floor(pos));
+  const auto hi = std::min(lo + 1, sorted_samples.size() - 1);
+  const double frac = pos - static_cast<double>(lo);
+  return sorted_samples[lo] + ((sorted_samples[hi] - sorted_samples[lo]) * frac);
+}
+
+/// @brief Computes summary statistics for the given time samples.
+inline PerfStatistics ComputePerfStatistics(std::vector<double> samples) {
+  PerfStatistics stats;
+  if (samples.empty()) {
+    return stats;
+  }
+  std::ranges::sort(samples);
+  const auto count = static_cast<double>(samples.size());
+  stats.min_sec = samples.front();
+  stats.median_sec = GetQuantile(samples, 0.5);
+  stats.mean_sec = std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+  stats.p90_sec = GetQuantile(samples, 0.9);
+  stats.p99_sec = GetQuantile(samples, 0.99);
+  double sq_sum = 0.0;
+  for (double sample : samples) {
+    sq_sum += (sample - stats.mean_sec) * (sample - stats.mean_sec);
+  }
+  stats.stddev_sec = samples.size() > 1 ? std::sqrt(sq_sum / (count - 1.0)) : 0.0;
+  return stats;
+}
+
+/// @brief Returns the relative half-width of the distribution-free 95% confidence interval of the median.
+/// @param sorted_samples Samples sorted in ascending order.
+/// @return Half-width divided by the median, or +inf if there are too few samples to bound the median.
+inline double GetMedianRelativeCI(const std::vector<double> &sorted_samples) {
+  constexpr double kZ = 1.96;
+  const auto n = static_cast<double>(sorted_samples.size());
+  const double spread = kZ * std::sqrt(n) / 2.0;
+  const double lo_rank = std::floor((n / 2.0) - spread);
+  const double hi_rank = std::ceil(1.0 + (n / 2.0) + spread);
+  if (lo_rank < 1.0 || hi_rank > n) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const double lo = sorted_samples[static_cast<std::size_t>(lo_rank) - 1];
+  const double hi = sorted_samples[static_cast<std::size_t>(hi_rank) - 1];
+  const double median = GetQuantile(sorted_samples, 0.5);
+  if (median <= 0.0) {
+    return hi > lo ? std::numeric_limits<double>::infinity() : 0.0;
+  }
+  return (hi - lo) / (2.0 * median);
+}
+
+/// @brief Spread of the measured time across processes.
+struct RankTimeStatistics {
+  double min_sec = 0.0;
+  double max_sec = 0.0;
+  double mean_sec = 0.0;
+  /// @brief max_sec / mean_sec; 1.0 means perfectly balanced work.
+  double imbalance_ratio = 0.0;
 };
 
+/// @brief Computes the spread of per-process times.
+inline RankTimeStatistics ComputeRankTimeStatistics(const std::vector<double> &rank_times) {
+  RankTimeStatistics stats;
+  if (rank_times.empty()) {
+    return stats;
+  }
+  const auto [min_it, max_it] = std::ranges::minmax_element(rank_times);
+  stats.min_sec = *min_it;
+  stats.max_sec = *max_it;
+  stats.mean_sec = std::accumulate(rank_times.begin(), rank_times.end(), 0.0) / static_cast<double>(rank_times.size());
+  stats.imbalance_ratio = stats.mean_sec > 0.0 ? stats.max_sec / stats.mean_sec : 1.0;
+  return stats;
+}
+
 struct PerfResults {
-  /// @brief Measured execution time in seconds.
+  /// @brief Measured execution time in seconds (mean over timed iterations).
   double time_sec = 0.0;
+  /// @brief Per-iteration execution times in seconds, warmup runs excluded.
+  std::vector<double> samples_sec;
+  /// @brief Summary statistics over samples_sec.
+  PerfStatistics statistics;
+  /// @brief Number of timed iterations actually executed.
+  uint64_t num_iterations = 0;
+  /// @brief time_sec of every process indexed by rank; empty unless set via Perf::SetRankTimes.
+  std::vector<double> rank_times_sec;
+  /// @brief Spread of rank_times_sec.
+  RankTimeStatistics rank_statistics;
+  /// @brief Hardware counter totals over the timed iterations; empty unless PerfAttr::collect_hw_counters is set.
+  std::optional<HwCounterValues> hw_counters;
+  /// @brief Number of threads the hardware counters were opened for (threads started later are inherited).
+  std::size_t hw_counter_threads = 0;
+  /// @brief Wall time of each pipeline stage over the timed iterations (on this process).
+  ppc::task::StageTimings stage_timings{};
   enum class TypeOfRunning : uint8_t {
     kPipeline,
     kTaskRun,
@@ -39,6 +191,54 @@ struct PerfResults {
   constexpr static double kMaxTime = 10.0;
 };
 
+inline std::string GetStringParamName(PerfResults::TypeOfRunning type_of_running) {
+  if (type_of_running == PerfResults::TypeOfRunning::kTaskRun) {
+    return "task_run";
+  }
+  if (type_of_running == PerfResults::TypeOfRunning::kPipeline) {
+    return "pipeline";
+  }
+  return "none";
+}
+
+/// @brief Appends a perf record produced by Perf::GetPerfRecord to a results file.
+/// @details Files ending with ".csv" get one CSV row per record (with a header for a new file),
+/// any other path gets one JSON object per line.
+/// @throws std::runtime_error If the file cannot be opened.
+inline void AppendPerfRecord(const nlohmann::json &record, const std::string &path) {
+  const bool is_csv = std::filesystem::path(path).extension() == ".csv";
+  std::error_code ec;
+  const bool write_header = is_csv && (!std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) == 0);
+  std::ofstream file(path, std::ios::app);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  if (!is_csv) {
+    file << record.dump() << '\n';
+    return;
+  }
+  if (write_header) {
+    file << "test_id,task,technology,type_of_running,num_proc,num_threads,num_iterations,time_sec,"
+            "min_sec,median_sec,mean_sec,p90_sec,p99_sec,stddev_sec,host,git_revision,samples_sec\n";
+  }
+  const auto &stats = record["statistics"];
+  std::stringstream samples;
+  samples << std::setprecision(10);
+  for (const auto &sample : record["samples_sec"]) {
+    samples << (samples.tellp() > 0 ? ";" : "") << sample.get<double>();
+  }
+  file << std::setprecision(10);
+  file << record["test_id"].get<std::string>() << ',' << record["task"].get<std::string>() << ','
+       << record["technology"].get<std::string>() << ',' << record["type_of_running"].get<std::string>() << ','
+       << record["num_proc"].get<int>() << ',' << record["num_threads"].get<int>() << ','
+       << record["num_iterations"].get<uint64_t>() << ',' << record["time_sec"].get<double>() << ','
+       << stats["min_sec"].get<double>() << ',' << stats["median_sec"].get<double>() << ','
+       << stats["mean_sec"].get<double>() << ',' << stats["p90_sec"].get<double>() << ','
+       << stats["p99_sec"].get<double>() << ',' << stats["stddev_sec"].get<double>() << ','
+       << record["host"]["name"].get<std::string>() << ',' << record["git_revision"].get<std::string>() << ','
+       << samples.str() << '\n';
+}
+
 template <typename InType, typename OutType>
 class Perf {
  public:
@@ -51,22 +251,30 @@ class Perf {
   void PipelineRun(const PerfAttr &perf_attr) {
     perf_results_.type_of_running = PerfResults::TypeOfRunning::kPipeline;
 
-    CommonRun(perf_attr, [&] {
+    // Between iterations and outside the measured time, the scratch arena grows to the footprint of the
+    // previous runs and a task that consumes its input gets it back
+    const auto prepare = [&] {
+      task_->ReserveScratch();
+      task_->RestoreInput();
+    };
+    CommonRun(perf_attr, prepare, [&] {
       task_->Validation();
       task_->PreProcessing();
       task_->Run();
       task_->PostProcessing();
-    }, perf_results_);
+    }, *task_, perf_results_);
   }
   // Check performance of task's Run() function
   void TaskRun(const PerfAttr &perf_attr) {
     perf_results_.type_of_running = PerfResults::TypeOfRunning::kTaskRun;
 
+    task_->ReserveScratch();
     task_->Validation();
     task_->PreProcessing();
-    CommonRun(perf_attr, [&] { task_->Run(); }, perf_results_);
+    CommonRun(perf_attr, {}, [&] { task_->Run(); }, *task_, perf_results_);
     task_->PostProcessing();
 
+    task_->RestoreInput();
     task_->Validation();
     task_->PreProcessing();
     task_->Run();
@@ -85,12 +293,20 @@ class Perf {
       throw std::runtime_error(err_msg.str().c_str());
     }
 
+    if (const auto output_path = ppc::util::GetPerfOutputPath(); !output_path.empty()) {
+      AppendPerfRecord(GetPerfRecord(test_id), output_path);
+    }
+
     auto time_secs = perf_results_.time_sec;
     const auto max_time = ppc::util::GetPerfMaxTime();
     std::stringstream perf_res_str;
     if (time_secs < max_time) {
       perf_res_str << std::fixed << std::setprecision(10) << time_secs;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      PrintSampleStatistic(test_id, type_test_name);
+      PrintRankStatistic(test_id, type_test_name);
+      PrintHwCounterStatistic(test_id, type_test_name);
+      PrintStageStatistic(test_id, type_test_name);
     } else {
       std::stringstream err_msg;
       err_msg << '\n' << "Task execute time need to be: ";
@@ -101,6 +317,88 @@ class Perf {
       throw std::runtime_error(err_msg.str().c_str());
     }
   }
+  /// @brief Attaches the times measured by every process to the results.
+  /// @param rank_times time_sec of each process indexed by rank.
+  void SetRankTimes(std::vector<double> rank_times) {
+    perf_results_.rank_statistics = ComputeRankTimeStatistics(rank_times);
+    perf_results_.rank_times_sec = std::move(rank_times);
+  }
+  /// @brief Adds an extra top-level section to the record returned by GetPerfRecord.
+  /// @param key Section name.
+  /// @param value Section content.
+  void AddRecordSection(const std::string &key, nlohmann::json value) {
+    extra_record_sections_[key] = std::move(value);
+  }
+  /// @brief Builds a structured description of the latest results and the environment they were measured in.
+  /// @param test_id Identifier of the performance test.
+  /// @return JSON object with task, technology, process/thread counts, samples, statistics, host and revision.
+  [[nodiscard]] nlohmann::json GetPerfRecord(const std::string &test_id) const {
+    const auto &stats = perf_results_.statistics;
+    const auto &task = *task_;
+    nlohmann::json record;
+    record["test_id"] = test_id;
+    record["task"] = ppc::util::GetNamespaceFromTypeName(typeid(task).name());
+    record["technology"] = ppc::task::TypeOfTaskToString(task_->GetDynamicTypeOfTask());
+    record["type_of_running"] = GetStringParamName(perf_results_.type_of_running);
+    record["num_proc"] = ppc::util::GetNumProc();
+    record["num_threads"] = ppc::util::GetNumThreads();
+    record["mpi_thread_level"] = ppc::util::GetStringMPIThreadLevel(ppc::util::GetMPIThreadLevel());
+    record["num_iterations"] = perf_results_.num_iterations;
+    record["time_sec"] = perf_results_.time_sec;
+    record["statistics"] = {{"min_sec", stats.min_sec},   {"median_sec", stats.median_sec},
+                            {"mean_sec", stats.mean_sec}, {"p90_sec", stats.p90_sec},
+                            {"p99_sec", stats.p99_sec},   {"stddev_sec", stats.stddev_sec}};
+    record["samples_sec"] = perf_results_.samples_sec;
+    if (!perf_results_.rank_times_sec.empty()) {
+      const auto &rank_stats = perf_results_.rank_statistics;
+      record["ranks"] = {{"times_sec", perf_results_.rank_times_sec},
+                         {"min_sec", rank_stats.min_sec},
+                         {"max_sec", rank_stats.max_sec},
+                         {"mean_sec", rank_stats.mean_sec},
+                         {"imbalance_ratio", rank_stats.imbalance_ratio}};
+    }
+    record["host"] = {{"name", ppc::util::GetHostName()},
+                      {"hardware_concurrency", std::thread::hardware_concurrency()}};
+    record["git_revision"] = ppc::util::GetGitRevision();
+    record["placement"] = ppc::util::PlacementToJson(ppc::util::GetPlacement());
+    auto stages_json = nlohmann::json::object();
+    for (std::size_t i = 0; i < ppc::task::kNumTaskStages; i++) {
+      const auto &timing = perf_results_.stage_timings[i];
+      if (timing.calls > 0) {
+        stages_json[ppc::task::GetStringTaskStage(static_cast<ppc::task::TaskStage>(i))] = {
+            {"calls", timing.calls},
+            {"total_sec", timing.time_sec},
+            {"mean_sec", timing.time_sec / static_cast<double>(timing.calls)}};
+      }
+    }
+    record["stages"] = stages_json;
+    if (perf_results_.hw_counters.has_value()) {
+      auto hw_json = nlohmann::json::object();
+      for (std::size_t i = 0; i < kNumHwCounters; i++) {
+        const auto per_iteration = GetHwCounterPerIteration(static_cast<HwCounter>(i));
+        hw_json[std::string(GetHwCounterName(static_cast<HwCounter>(i)))] =
+            per_iteration.has_value() ? nlohmann::json(*per_iteration) : nlohmann::json(nullptr);
+      }
+      record["hw_counters_per_iteration"] = hw_json;
+      record["hw_counter_threads"] = perf_results_.hw_counter_threads;
+    }
+    for (const auto &[key, value] : extra_record_sections_.items()) {
+      record[key] = value;
+    }
+    return record;
+  }
+  /// @brief Returns the average value of a hardware counter per timed iteration.
+  /// @return std::nullopt if counters were not collected or the event is unavailable.
+  [[nodiscard]] std::optional<double> GetHwCounterPerIteration(HwCounter counter) const {
+    if (!perf_results_.hw_counters.has_value() || perf_results_.num_iterations == 0) {
+      return std::nullopt;
+    }
+    const auto &value = (*perf_results_.hw_counters)[static_cast<std::size_t>(counter)];
+    if (!value.has_value()) {
+      return std::nullopt;
+    }
+    return static_cast<double>(*value) / static_cast<double>(perf_results_.num_iterations);
+  }
   /// @brief Retrieves the performance test results.
   /// @return The latest PerfResults structure.
   [[nodiscard]] PerfResults GetPerfResults() const {
@@ -109,25 +407,160 @@ class Perf {
 
  private:
   PerfResults perf_results_;
+  nlohmann::json extra_record_sections_ = nlohmann::json::object();
   std::shared_ptr<ppc::task::Task<InType, OutType>> task_;
-  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results) {
-    auto begin = perf_attr.current_timer();
-    for (uint64_t i = 0; i < perf_attr.num_running; i++) {
-      pipeline();
+  void PrintSampleStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &stats = perf_results_.statistics;
+    std::stringstream stats_str;
+    stats_str << std::fixed << std::setprecision(10);
+    stats_str << test_id << ":" << type_test_name << ":stats";
+    stats_str << " n=" << perf_results_.samples_sec.size();
+    stats_str << " min=" << stats.min_sec << " median=" << stats.median_sec << " mean=" << stats.mean_sec;
+    stats_str << " p90=" << stats.p90_sec << " p99=" << stats.p99_sec << " stddev=" << stats.stddev_sec;
+    std::cout << stats_str.str() << '\n';
+  }
+  void PrintRankStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    if (perf_results_.rank_times_sec.size() < 2) {
+      return;
     }
-    auto end = perf_attr.current_timer();
-    perf_results.time_sec = (end - begin) / static_cast<double>(perf_attr.num_running);
+    const auto &stats = perf_results_.rank_statistics;
+    std::stringstream ranks_str;
+    ranks_str << std::fixed << std::setprecision(10);
+    ranks_str << test_id << ":" << type_test_name << ":ranks";
+    ranks_str << " n=" << perf_results_.rank_times_sec.size();
+    ranks_str << " min=" << stats.min_sec << " max=" << stats.max_sec << " mean=" << stats.mean_sec;
+    ranks_str << " imbalance=" << stats.imbalance_ratio;
+    std::cout << ranks_str.str() << '\n';
   }
-};
+  void PrintHwCounterStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    if (!perf_results_.hw_counters.has_value()) {
+      return;
+    }
+    std::stringstream hw_str;
+    hw_str << std::fixed << std::setprecision(2);
+    hw_str << test_id << ":" << type_test_name << ":hw";
+    for (std::size_t i = 0; i < kNumHwCounters; i++) {
+      const auto counter = static_cast<HwCounter>(i);
+      hw_str << " " << GetHwCounterName(counter) << "=";
+      if (const auto value = GetHwCounterPerIteration(counter); value.has_value()) {
+        hw_str << *value;
+      } else {
+        hw_str << "unavailable";
+      }
+    }
+    const auto cycles = GetHwCounterPerIteration(HwCounter::kCycles);
+    const auto instructions = GetHwCounterPerIteration(HwCounter::kInstructions);
+    if (cycles.has_value() && instructions.has_value() && *cycles > 0.0) {
+      hw_str << " ipc=" << (*instructions / *cycles);
+    }
+    hw_str << " threads=" << perf_results_.hw_counter_threads;
+    std::cout << hw_str.str() << '\n';
+  }
+  void PrintStageStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    std::stringstream stages_str;
+    stages_str << std::fixed << std::setprecision(10);
+    stages_str << test_id << ":" << type_test_name << ":stages";
+    for (std::size_t i = 0; i < ppc::task::kNumTaskStages; i++) {
+      const auto &timing = perf_results_.stage_timings[i];
+      if (timing.calls > 0) {
+        stages_str << " " << ppc::task::GetStringTaskStage(static_cast<ppc::task::TaskStage>(i)) << "="
+                   << timing.time_sec / static_cast<double>(timing.calls);
+      }
+    }
+    std::cout << stages_str.str() << '\n';
+  }
+  static std::vector<double> AdaptiveRun(const PerfAttr &perf_attr, const std::function<double()> &run_iteration) {
+    const double budget = perf_attr.time_budget_sec > 0.0 ? perf_attr.time_budget_sec : ppc::util::GetPerfMaxTime();
+    const uint64_t max_running = std::max<uint64_t>(perf_attr.max_running, 1);
+    std::vector<double> samples;
+    std::vector<double> sorted_samples;
+    double elapsed = 0.0;
+    for (uint64_t i = 0; i < max_running; i++) {
+      samples.push_back(run_iteration());
+      elapsed += samples.back();
 
-inline std::string GetStringParamName(PerfResults::TypeOfRunning type_of_running) {
-  if (type_of_running == PerfResults::TypeOfRunning::kTaskRun) {
-    return "task_run";
+      bool local_stop = elapsed >= budget;
+      if (!local_stop && samples.size() >= perf_attr.min_running) {
+        sorted_samples = samples;
+        std::ranges::sort(sorted_samples);
+        local_stop = GetMedianRelativeCI(sorted_samples) <= perf_attr.target_relative_ci;
+      }
+      // Every process has to take part in the decision, otherwise collectives inside the task would hang
+      if (perf_attr.stop_consensus(local_stop)) {
+        break;
+      }
+    }
+    return samples;
   }
-  if (type_of_running == PerfResults::TypeOfRunning::kPipeline) {
-    return "pipeline";
+  /// @param prepare Optional untimed step executed before every iteration.
+  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &prepare,
+                        const std::function<void()> &pipeline, ppc::task::Task<InType, OutType> &task,
+                        PerfResults &perf_results) {
+    for (uint64_t i = 0; i < perf_attr.num_warmup; i++) {
+      if (prepare) {
+        prepare();
+      }
+      pipeline();
+    }
+    task.ResetStageTimings();
+    // Counters and the allocation tracker only see the timed pipeline calls, not prepare() or the loop around them
+    std::optional<HwCounterGroup> hw_counter_group;
+    if (perf_attr.collect_hw_counters) {
+      hw_counter_group.emplace();
+      hw_counter_group->Start();
+      hw_counter_group->Stop();
+    }
+    if (perf_attr.track_allocations) {
+      alloc_tracker::Start();
+      alloc_tracker::Pause();
+    }
+    const auto run_iteration = [&] {
+      if (prepare) {
+        prepare();
+      }
+      if (hw_counter_group.has_value()) {
+        hw_counter_group->Resume();
+      }
+      if (perf_attr.track_allocations) {
+        alloc_tracker::Resume();
+      }
+      auto begin = perf_attr.current_timer();
+      pipeline();
+      auto end = perf_attr.current_timer();
+      if (perf_attr.track_allocations) {
+        alloc_tracker::Pause();
+      }
+      if (hw_counter_group.has_value()) {
+        hw_counter_group->Stop();
+      }
+      return end - begin;
+    };
+    std::vector<double> samples;
+    if (perf_attr.iteration_policy == IterationPolicy::kAdaptive) {
+      samples = AdaptiveRun(perf_attr, run_iteration);
+    } else {
+      samples.reserve(perf_attr.num_running);
+      for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+        samples.push_back(run_iteration());
+      }
+    }
+    if (perf_attr.track_allocations) {
+      alloc_tracker::Stop();
+    }
+    perf_results.hw_counters.reset();
+    perf_results.hw_counter_threads = 0;
+    if (hw_counter_group.has_value()) {
+      perf_results.hw_counters = hw_counter_group->Read();
+      perf_results.hw_counter_threads = hw_counter_group->GetNumThreads();
+    }
+    perf_results.stage_timings = task.GetStageTimings();
+    perf_results.num_iterations = samples.size();
+    perf_results.rank_times_sec.clear();
+    perf_results.rank_statistics = {};
+    perf_results.statistics = ComputePerfStatistics(samples);
+    perf_results.time_sec = perf_results.statistics.mean_sec;
+    perf_results.samples_sec = std::move(samples);
   }
-  return "none";
-}
+};
 
 }  // namespace ppc::performance
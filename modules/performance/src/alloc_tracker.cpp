@@ -0,0 +1,177 @@
+#include "performance/include/alloc_tracker.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+#ifdef __linux__
+#  include <cstdio>
+#  include <cstring>
+#elif !defined(_WIN32)
+#  include <sys/resource.h>
+#endif
+
+namespace ppc::performance::alloc_tracker {
+
+namespace {
+
+std::atomic<bool> active{false};
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> deallocations{0};
+std::atomic<uint64_t> bytes{0};
+uint64_t peak_rss_kib = 0;
+
+#ifdef __linux__
+void ResetPeakRss() {
+  // Writing 5 to clear_refs resets VmHWM (Linux 4.0+); without permission VmHWM stays the process peak
+  if (std::FILE *file = std::fopen("/proc/self/clear_refs", "w")) {
+    std::fputs("5", file);
+    std::fclose(file);
+  }
+}
+
+uint64_t ReadPeakRssKib() {
+  std::FILE *file = std::fopen("/proc/self/status", "r");
+  if (file == nullptr) {
+    return 0;
+  }
+  std::array<char, 256> line{};
+  unsigned long long value = 0;
+  while (std::fgets(line.data(), static_cast<int>(line.size()), file) != nullptr) {
+    if (std::strncmp(line.data(), "VmHWM:", 6) == 0) {
+      std::sscanf(line.data() + 6, "%llu", &value);
+      break;
+    }
+  }
+  std::fclose(file);
+  return value;
+}
+#elif defined(_WIN32)
+void ResetPeakRss() {}
+
+uint64_t ReadPeakRssKib() {
+  return 0;
+}
+#else
+void ResetPeakRss() {}
+
+uint64_t ReadPeakRssKib() {
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  // ru_maxrss is reported in bytes on macOS
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+}
+#endif
+
+}  // namespace
+
+void Start() {
+  active.store(false);
+  allocations.store(0);
+  deallocations.store(0);
+  bytes.store(0);
+  peak_rss_kib = 0;
+  ResetPeakRss();
+  active.store(true);
+}
+
+void Stop() {
+  active.store(false);
+  peak_rss_kib = ReadPeakRssKib();
+}
+
+void Pause() {
+  active.store(false);
+}
+
+void Resume() {
+  active.store(true);
+}
+
+bool IsActive() {
+  return active.load();
+}
+
+void RecordAllocation(std::size_t size) noexcept {
+  if (active.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+}
+
+void RecordDeallocation() noexcept {
+  if (active.load(std::memory_order_relaxed)) {
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+AllocStats GetLocalStats() {
+  return {.allocations = allocations.load(),
+          .deallocations = deallocations.load(),
+          .bytes = bytes.load(),
+          .peak_rss_kib = peak_rss_kib};
+}
+
+std::vector<AllocStats> GatherStats() {
+  const auto local_stats = GetLocalStats();
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    return {local_stats};
+  }
+
+  constexpr int kFields = 4;
+  const std::array<uint64_t, kFields> local = {local_stats.allocations, local_stats.deallocations, local_stats.bytes,
+                                               local_stats.peak_rss_kib};
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  std::vector<uint64_t> all(rank == 0 ? static_cast<std::size_t>(size) * kFields : 0);
+  MPI_Gather(local.data(), kFields, MPI_UINT64_T, all.data(), kFields, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+  std::vector<AllocStats> stats(rank == 0 ? static_cast<std::size_t>(size) : 0);
+  for (std::size_t proc = 0; proc < stats.size(); proc++) {
+    const auto *values = all.data() + (proc * kFields);
+    stats[proc] = {.allocations = values[0], .deallocations = values[1], .bytes = values[2], .peak_rss_kib = values[3]};
+  }
+  return stats;
+}
+
+nlohmann::json StatsToJson(const std::vector<AllocStats> &stats) {
+  auto result = nlohmann::json::array();
+  for (const auto &rank_stats : stats) {
+    result.push_back({{"allocations", rank_stats.allocations},
+                      {"deallocations", rank_stats.deallocations},
+                      {"bytes", rank_stats.bytes},
+                      {"peak_rss_kib", rank_stats.peak_rss_kib}});
+  }
+  return result;
+}
+
+std::string FormatStats(const std::string &prefix, const std::vector<AllocStats> &stats) {
+  AllocStats total;
+  for (const auto &rank_stats : stats) {
+    total.allocations += rank_stats.allocations;
+    total.deallocations += rank_stats.deallocations;
+    total.bytes += rank_stats.bytes;
+    total.peak_rss_kib = std::max(total.peak_rss_kib, rank_stats.peak_rss_kib);
+  }
+  std::stringstream out;
+  out << prefix << ":allocs allocations=" << total.allocations << " deallocations=" << total.deallocations
+      << " bytes=" << total.bytes << " max_rank_peak_rss_kib=" << total.peak_rss_kib << '\n';
+  return out.str();
+}
+
+}  // namespace ppc::performance::alloc_tracker
@@ -0,0 +1,167 @@
+#include "performance/include/hw_counters.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  include <charconv>
+#  include <cstring>
+#  include <filesystem>
+#  include <system_error>
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+constexpr std::array<std::string_view, kNumHwCounters> kHwCounterNames = {"cycles", "instructions", "llc_misses",
+                                                                          "branch_misses"};
+
+#ifdef __linux__
+int OpenCounter(HwCounter counter, pid_t tid) {
+  perf_event_attr attr{};
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  switch (counter) {
+    case HwCounter::kCycles:
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case HwCounter::kInstructions:
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case HwCounter::kLlcMisses:
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    case HwCounter::kBranchMisses:
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    case HwCounter::kCount:
+      return -1;
+  }
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+}
+
+/// An event opened for the process only follows threads created afterwards, so thread pools that are
+/// already running (OpenMP, TBB) have to be opened one by one
+std::vector<pid_t> GetProcessThreads() {
+  std::vector<pid_t> tids;
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+    const auto name = entry.path().filename().string();
+    pid_t tid = 0;
+    const auto [ptr, err] = std::from_chars(name.data(), name.data() + name.size(), tid);
+    if (err == std::errc() && ptr == name.data() + name.size()) {
+      tids.push_back(tid);
+    }
+  }
+  if (tids.empty()) {
+    tids.push_back(0);
+  }
+  return tids;
+}
+#endif
+
+}  // namespace
+
+std::string_view GetHwCounterName(HwCounter counter) {
+  const auto index = static_cast<std::size_t>(counter);
+  return index < kNumHwCounters ? kHwCounterNames[index] : std::string_view("unknown");
+}
+
+HwCounterGroup::HwCounterGroup() {
+#ifdef __linux__
+  for (const pid_t tid : GetProcessThreads()) {
+    bool opened = false;
+    for (std::size_t i = 0; i < kNumHwCounters; i++) {
+      const int fd = OpenCounter(static_cast<HwCounter>(i), tid);
+      if (fd >= 0) {
+        fds_[i].push_back(fd);
+        opened = true;
+      }
+    }
+    if (opened) {
+      num_threads_++;
+    }
+  }
+#endif
+}
+
+HwCounterGroup::~HwCounterGroup() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+bool HwCounterGroup::IsAvailable() const {
+  return num_threads_ > 0;
+}
+
+std::size_t HwCounterGroup::GetNumThreads() const {
+  return num_threads_;
+}
+
+void HwCounterGroup::Start() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+void HwCounterGroup::Stop() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+#endif
+}
+
+void HwCounterGroup::Resume() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+HwCounterValues HwCounterGroup::Read() const {
+  HwCounterValues values{};
+#ifdef __linux__
+  for (std::size_t i = 0; i < kNumHwCounters; i++) {
+    for (int fd : fds_[i]) {
+      uint64_t value = 0;
+      if (read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+        values[i] = values[i].value_or(0) + value;
+      }
+    }
+  }
+#endif
+  return values;
+}
+
+}  // namespace ppc::performance
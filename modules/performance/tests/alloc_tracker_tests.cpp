@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "performance/include/alloc_tracker.hpp"
+
+namespace alloc_tracker = ppc::performance::alloc_tracker;
+
+TEST(AllocTrackerTest, CountsOnlyBetweenStartAndStop) {
+  alloc_tracker::RecordAllocation(64);
+  EXPECT_FALSE(alloc_tracker::IsActive());
+
+  alloc_tracker::Start();
+  EXPECT_TRUE(alloc_tracker::IsActive());
+  alloc_tracker::RecordAllocation(100);
+  alloc_tracker::RecordAllocation(28);
+  alloc_tracker::RecordDeallocation();
+  alloc_tracker::Stop();
+  alloc_tracker::RecordAllocation(1000);
+
+  const auto stats = alloc_tracker::GetLocalStats();
+  EXPECT_EQ(stats.allocations, 2U);
+  EXPECT_EQ(stats.deallocations, 1U);
+  EXPECT_EQ(stats.bytes, 128U);
+#ifdef __linux__
+  EXPECT_GT(stats.peak_rss_kib, 0U);
+#endif
+}
+
+TEST(AllocTrackerTest, FormatsTotalsOverRanks) {
+  const std::vector<alloc_tracker::AllocStats> stats = {
+      {.allocations = 3, .deallocations = 2, .bytes = 300, .peak_rss_kib = 1024},
+      {.allocations = 1, .deallocations = 1, .bytes = 50, .peak_rss_kib = 2048}};
+  EXPECT_EQ(alloc_tracker::FormatStats("task:pipeline", stats),
+            "task:pipeline:allocs allocations=4 deallocations=3 bytes=350 max_rank_peak_rss_kib=2048\n");
+  const auto json = alloc_tracker::StatsToJson(stats);
+  ASSERT_EQ(json.size(), 2U);
+  EXPECT_EQ(json[1]["bytes"], 50);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -8,10 +11,13 @@
 #include <memory>
 #include <ostream>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include "performance/include/alloc_tracker.hpp"
 #include "performance/include/performance.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
@@ -313,6 +319,98 @@ TEST(TaskTest, GetDynamicTypeReturnsCorrectEnum) {
   EXPECT_EQ(task.GetDynamicTypeOfTask(), TypeOfTask::kOMP);
 }
 
+TEST(TaskTest, StageTimingsCountEveryStageCall) {
+  DummyTask task;
+  for (int i = 0; i < 2; i++) {
+    task.Validation();
+    task.PreProcessing();
+    task.Run();
+    task.Run();
+    task.PostProcessing();
+  }
+  const auto &timings = task.GetStageTimings();
+  EXPECT_EQ(timings[static_cast<std::size_t>(ppc::task::TaskStage::kValidation)].calls, 2U);
+  EXPECT_EQ(timings[static_cast<std::size_t>(ppc::task::TaskStage::kRun)].calls, 4U);
+  EXPECT_EQ(ppc::task::GetStringTaskStage(ppc::task::TaskStage::kPostProcessing), "post_processing");
+
+  task.ResetStageTimings();
+  EXPECT_EQ(task.GetStageTimings()[static_cast<std::size_t>(ppc::task::TaskStage::kRun)].calls, 0U);
+}
+
+class ConsumingTask : public Task<std::vector<int>, int> {
+ public:
+  explicit ConsumingTask(const std::vector<int> &in) {
+    GetInput() = in;
+    SnapshotInput();
+  }
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+  bool PreProcessingImpl() override {
+    data_ = std::move(GetInput());
+    return true;
+  }
+  bool RunImpl() override {
+    GetOutput() = 0;
+    for (int value : data_) {
+      GetOutput() += value;
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+
+ private:
+  std::vector<int> data_;
+};
+
+TEST(TaskTest, ResetRestoresConsumedInput) {
+  ConsumingTask task({1, 2, 3});
+  ASSERT_TRUE(task.HasInputSnapshot());
+  task.Validation();
+  task.PreProcessing();
+  EXPECT_THROW(task.Reset(), std::runtime_error);
+  task.Run();
+  task.PostProcessing();
+  EXPECT_TRUE(task.GetInput().empty());
+  EXPECT_EQ(task.GetOutput(), 6);
+
+  task.Reset();
+  EXPECT_EQ(task.GetInput(), (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(task.GetOutput(), 0);
+  EXPECT_TRUE(task.Validation());
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+  EXPECT_EQ(task.GetOutput(), 6);
+}
+
+TEST(TaskTest, RebindReplacesInputAndSnapshot) {
+  ConsumingTask task({1, 2, 3});
+  task.Rebind({10, 20});
+  task.Validation();
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+  EXPECT_EQ(task.GetOutput(), 30);
+  task.Reset();
+  EXPECT_EQ(task.GetInput(), (std::vector<int>{10, 20}));
+}
+
+TEST(PerfTest, PipelineRunRestoresConsumedInputBetweenIterations) {
+  auto task_ptr = std::make_shared<ConsumingTask>(std::vector<int>{1, 2, 3});
+  Perf<std::vector<int>, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 1;
+  EXPECT_NO_THROW(perf.PipelineRun(attr));
+  EXPECT_EQ(task_ptr->GetOutput(), 6);
+  EXPECT_NO_THROW(perf.TaskRun(attr));
+  EXPECT_EQ(task_ptr->GetOutput(), 6);
+}
+
 TEST(TaskTest, DestructorTerminatesIfWrongOrder) {
   DummyTask task;
   EXPECT_THROW(task.Run(), std::runtime_error);
@@ -371,6 +469,345 @@ TEST(PerfTest, PipelineRunAndTaskRun) {
   EXPECT_GT(res_taskrun.time_sec, 0.0);
 }
 
+TEST(PerfTest, CommonRunCollectsPerIterationSamples) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  double time = 0.0;
+  double step = 1.0;
+  attr.num_running = 4;
+  attr.current_timer = [&time, &step]() {
+    double t = time;
+    time += step;
+    step += 1.0;
+    return t;
+  };
+
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  ASSERT_EQ(res.samples_sec.size(), 4U);
+  EXPECT_DOUBLE_EQ(res.samples_sec[0], 1.0);
+  EXPECT_DOUBLE_EQ(res.samples_sec[3], 7.0);
+  EXPECT_DOUBLE_EQ(res.statistics.min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(res.statistics.median_sec, 4.0);
+  EXPECT_DOUBLE_EQ(res.statistics.mean_sec, 4.0);
+  EXPECT_DOUBLE_EQ(res.time_sec, res.statistics.mean_sec);
+}
+
+TEST(PerfTest, AllocationsAreTrackedOnlyInTimedIterations) {
+  class AllocatingTask : public ConsumingTask {
+   public:
+    using ConsumingTask::ConsumingTask;
+    bool RunImpl() override {
+      ppc::performance::alloc_tracker::RecordAllocation(8);
+      return ConsumingTask::RunImpl();
+    }
+  };
+  auto task_ptr = std::make_shared<AllocatingTask>(std::vector<int>{1, 2, 3});
+  Perf<std::vector<int>, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 2;
+  attr.track_allocations = true;
+  perf.PipelineRun(attr);
+  EXPECT_FALSE(ppc::performance::alloc_tracker::IsActive());
+  const auto stats = ppc::performance::alloc_tracker::GetLocalStats();
+  EXPECT_EQ(stats.allocations, 3U);
+  EXPECT_EQ(stats.bytes, 24U);
+}
+
+TEST(PerfTest, WarmupRunsAreNotTimed) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  int timer_calls = 0;
+  attr.num_running = 3;
+  attr.num_warmup = 2;
+  attr.current_timer = [&timer_calls]() { return static_cast<double>(timer_calls++); };
+
+  perf.TaskRun(attr);
+  EXPECT_EQ(timer_calls, 6);
+  EXPECT_EQ(perf.GetPerfResults().samples_sec.size(), 3U);
+}
+
+TEST(PerfTest, PipelineRunRecordsStageTimings) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 2;
+  perf.PipelineRun(attr);
+
+  const auto &timings = perf.GetPerfResults().stage_timings;
+  for (const auto &timing : timings) {
+    EXPECT_EQ(timing.calls, 3U);
+    EXPECT_GE(timing.time_sec, 0.0);
+  }
+  const auto record = perf.GetPerfRecord("stage_test");
+  EXPECT_EQ(record["stages"]["run"]["calls"].get<uint64_t>(), 3U);
+  EXPECT_TRUE(record["stages"].contains("pre_processing"));
+}
+
+TEST(PerfTest, TaskRunRecordsOnlyRunStage) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 4;
+  perf.TaskRun(attr);
+
+  const auto &timings = perf.GetPerfResults().stage_timings;
+  EXPECT_EQ(timings[static_cast<std::size_t>(ppc::task::TaskStage::kRun)].calls, 4U);
+  EXPECT_EQ(timings[static_cast<std::size_t>(ppc::task::TaskStage::kValidation)].calls, 0U);
+  EXPECT_FALSE(perf.GetPerfRecord("stage_test")["stages"].contains("validation"));
+}
+
+TEST(PerfTest, ComputePerfStatisticsHandlesEdgeCases) {
+  const auto empty = ComputePerfStatistics({});
+  EXPECT_DOUBLE_EQ(empty.mean_sec, 0.0);
+
+  const auto single = ComputePerfStatistics({2.5});
+  EXPECT_DOUBLE_EQ(single.min_sec, 2.5);
+  EXPECT_DOUBLE_EQ(single.p99_sec, 2.5);
+  EXPECT_DOUBLE_EQ(single.stddev_sec, 0.0);
+
+  std::vector<double> samples(100);
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    samples[i] = static_cast<double>(samples.size() - i);
+  }
+  const auto stats = ComputePerfStatistics(samples);
+  EXPECT_DOUBLE_EQ(stats.min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(stats.median_sec, 50.5);
+  EXPECT_NEAR(stats.p90_sec, 90.1, 1e-9);
+  EXPECT_NEAR(stats.p99_sec, 99.01, 1e-9);
+  EXPECT_GT(stats.stddev_sec, 0.0);
+}
+
+TEST(PerfTest, AdaptiveRunStopsWhenMedianIsStable) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  double time = 0.0;
+  attr.iteration_policy = IterationPolicy::kAdaptive;
+  attr.min_running = 7;
+  attr.time_budget_sec = 1e9;
+  attr.current_timer = [&time]() {
+    double t = time;
+    time += 0.5;
+    return t;
+  };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().num_iterations, 8U);
+  EXPECT_DOUBLE_EQ(perf.GetPerfResults().statistics.median_sec, 0.5);
+}
+
+TEST(PerfTest, AdaptiveRunRespectsTimeBudget) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  double time = 0.0;
+  attr.iteration_policy = IterationPolicy::kAdaptive;
+  attr.target_relative_ci = -1.0;
+  attr.time_budget_sec = 10.0;
+  attr.current_timer = [&time]() {
+    double t = time;
+    time += 2.0;
+    return t;
+  };
+
+  perf.TaskRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().num_iterations, 5U);
+}
+
+TEST(PerfTest, AdaptiveRunFollowsStopConsensus) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  int consensus_calls = 0;
+  attr.iteration_policy = IterationPolicy::kAdaptive;
+  attr.max_running = 12;
+  attr.time_budget_sec = 1e-12;
+  attr.current_timer = [] { return 1.0; };
+  attr.stop_consensus = [&consensus_calls](bool /*local_stop*/) {
+    consensus_calls++;
+    return false;
+  };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().num_iterations, 12U);
+  EXPECT_EQ(consensus_calls, 12);
+}
+
+TEST(PerfTest, MedianRelativeCINeedsEnoughSamples) {
+  EXPECT_TRUE(std::isinf(GetMedianRelativeCI({1.0, 1.0, 1.0})));
+  EXPECT_DOUBLE_EQ(GetMedianRelativeCI(std::vector<double>(20, 1.0)), 0.0);
+  std::vector<double> samples(20);
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    samples[i] = 1.0 + (0.01 * static_cast<double>(i));
+  }
+  const double rel_ci = GetMedianRelativeCI(samples);
+  EXPECT_GT(rel_ci, 0.0);
+  EXPECT_LT(rel_ci, 0.1);
+}
+
+TEST(PerfTest, GetPerfRecordDescribesTaskAndSamples) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  task_ptr->SetTypeOfTask(TypeOfTask::kSEQ);
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  double time = 0.0;
+  attr.num_running = 3;
+  attr.current_timer = [&time]() {
+    double t = time;
+    time += 0.25;
+    return t;
+  };
+  perf.PipelineRun(attr);
+
+  const auto record = perf.GetPerfRecord("record_test");
+  EXPECT_EQ(record["test_id"], "record_test");
+  EXPECT_EQ(record["task"], "ppc::performance");
+  EXPECT_EQ(record["technology"], "seq");
+  EXPECT_EQ(record["type_of_running"], "pipeline");
+  EXPECT_EQ(record["num_iterations"], 3U);
+  ASSERT_EQ(record["samples_sec"].size(), 3U);
+  EXPECT_DOUBLE_EQ(record["statistics"]["median_sec"].get<double>(), 0.25);
+  EXPECT_FALSE(record["host"]["name"].get<std::string>().empty());
+  EXPECT_TRUE(record.contains("git_revision"));
+}
+
+TEST(PerfTest, PrintPerfStatisticAppendsRecordsToOutputFile) {
+  for (const std::string ext : {".jsonl", ".csv"}) {
+    const auto path = (std::filesystem::temp_directory_path() / ("ppc_perf_output_test" + ext)).string();
+    std::filesystem::remove(path);
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_OUTPUT", path);
+
+    auto task_ptr = std::make_shared<DummyTask>();
+    Perf<int, int> perf(task_ptr);
+    PerfAttr attr;
+    double time = 0.0;
+    attr.current_timer = [&time]() { return time += 0.001; };
+    perf.PipelineRun(attr);
+    perf.PrintPerfStatistic("output_first");
+    perf.TaskRun(attr);
+    perf.PrintPerfStatistic("output_second");
+
+    std::ifstream file(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);) {
+      lines.push_back(line);
+    }
+    if (ext == ".csv") {
+      ASSERT_EQ(lines.size(), 3U);
+      EXPECT_TRUE(lines[0].starts_with("test_id,task,technology"));
+      EXPECT_TRUE(lines[2].starts_with("output_second,"));
+    } else {
+      ASSERT_EQ(lines.size(), 2U);
+      EXPECT_EQ(nlohmann::json::parse(lines[1])["type_of_running"], "task_run");
+    }
+    file.close();
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(PerfTest, SetRankTimesReportsImbalance) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.current_timer = [] { return 0.0; };
+  perf.PipelineRun(attr);
+
+  perf.SetRankTimes({1.0, 1.0, 1.0, 5.0});
+  const auto res = perf.GetPerfResults();
+  EXPECT_DOUBLE_EQ(res.rank_statistics.min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(res.rank_statistics.max_sec, 5.0);
+  EXPECT_DOUBLE_EQ(res.rank_statistics.mean_sec, 2.0);
+  EXPECT_DOUBLE_EQ(res.rank_statistics.imbalance_ratio, 2.5);
+  EXPECT_EQ(perf.GetPerfRecord("ranks")["ranks"]["times_sec"].size(), 4U);
+
+  perf.PipelineRun(attr);
+  EXPECT_TRUE(perf.GetPerfResults().rank_times_sec.empty());
+  EXPECT_FALSE(perf.GetPerfRecord("ranks").contains("ranks"));
+}
+
+TEST(PerfTest, HwCounterGroupDegradesGracefully) {
+  HwCounterGroup group;
+  group.Start();
+  volatile uint64_t sink = 0;
+  for (uint64_t i = 0; i < 100000; i++) {
+    sink = sink + i;
+  }
+  group.Stop();
+  const auto values = group.Read();
+  if (!group.IsAvailable()) {
+    for (const auto &value : values) {
+      EXPECT_FALSE(value.has_value());
+    }
+    GTEST_SKIP() << "Hardware counters are not available on this system";
+  }
+  const auto &instructions = values[static_cast<std::size_t>(HwCounter::kInstructions)];
+  if (instructions.has_value()) {
+    EXPECT_GT(*instructions, 0U);
+  }
+}
+
+TEST(PerfTest, HwCounterGroupCountsThreadsStartedBeforeIt) {
+  std::atomic<bool> go{false};
+  std::atomic<uint64_t> sink{0};
+  std::thread worker([&] {
+    while (!go.load()) {
+      std::this_thread::yield();
+    }
+    uint64_t local = 0;
+    for (uint64_t i = 0; i < 10000000; i++) {
+      local += i ^ (local >> 3);
+    }
+    sink.store(local);
+  });
+  HwCounterGroup group;
+  if (!group.IsAvailable()) {
+    go.store(true);
+    worker.join();
+    GTEST_SKIP() << "Hardware counters are not available on this system";
+  }
+  EXPECT_GE(group.GetNumThreads(), 2U);
+  group.Start();
+  go.store(true);
+  worker.join();
+  group.Stop();
+  const auto values = group.Read();
+  const auto &instructions = values[static_cast<std::size_t>(HwCounter::kInstructions)];
+  if (instructions.has_value()) {
+    EXPECT_GT(*instructions, 10000000U);
+  }
+}
+
+TEST(PerfTest, CollectHwCountersFillsResults) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.current_timer = [] { return 0.0; };
+
+  perf.PipelineRun(attr);
+  EXPECT_FALSE(perf.GetPerfResults().hw_counters.has_value());
+  EXPECT_FALSE(perf.GetPerfRecord("hw").contains("hw_counters_per_iteration"));
+
+  attr.collect_hw_counters = true;
+  perf.PipelineRun(attr);
+  EXPECT_TRUE(perf.GetPerfResults().hw_counters.has_value());
+  EXPECT_EQ(perf.GetPerfRecord("hw")["hw_counters_per_iteration"].size(), kNumHwCounters);
+  EXPECT_NO_THROW(perf.PrintPerfStatistic("hw"));
+}
+
 TEST(PerfTest, PrintPerfStatisticThrowsOnNone) {
   {
     auto task_ptr = std::make_shared<DummyTask>();
@@ -37,6 +37,8 @@ class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
 };
 
 /// @brief Initializes the testing environment (e.g., MPI, logging).
+/// @details MPI is initialized with MPI_Init_thread at the level given by PPC_MPI_THREAD_LEVEL
+/// (see ppc::util::GetMPIThreadLevelRequired()); the run aborts if the library provides less.
 /// @param argc Argument count.
 /// @param argv Argument vector.
 /// @return Exit code from RUN_ALL_TESTS or MPI error code if initialization/
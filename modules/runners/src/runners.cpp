@@ -16,6 +16,7 @@
 #include <string_view>
 
 #include "oneapi/tbb/global_control.h"
+#include "util/include/placement.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::runners {
@@ -140,12 +141,35 @@ int RunAllTestsSafely() {
 }  // namespace
 
 int Init(int argc, char **argv) {
-  const int init_res = MPI_Init(&argc, &argv);
+  ppc::util::MPIThreadLevel required_level{};
+  ppc::util::BindMode bind_mode{};
+  try {
+    required_level = ppc::util::GetMPIThreadLevelRequired();
+    bind_mode = ppc::util::GetBindMode();
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    return EXIT_FAILURE;
+  }
+
+  // Hybrid (kALL) tasks run OpenMP, TBB and std::thread workers inside ranks, so ask MPI for thread support
+  int provided = MPI_THREAD_SINGLE;
+  const int init_res = MPI_Init_thread(&argc, &argv, ppc::util::ToMPIThreadLevel(required_level), &provided);
   if (init_res != MPI_SUCCESS) {
-    std::cerr << std::format("[  ERROR  ] MPI_Init failed with code {}", init_res) << '\n';
+    std::cerr << std::format("[  ERROR  ] MPI_Init_thread failed with code {}", init_res) << '\n';
     MPI_Abort(MPI_COMM_WORLD, init_res);
     return init_res;
   }
+  if (const auto provided_level = ppc::util::FromMPIThreadLevel(provided); provided_level < required_level) {
+    std::cerr << std::format("[  ERROR  ] MPI provides thread level '{}', but PPC_MPI_THREAD_LEVEL requires '{}'",
+                             ppc::util::GetStringMPIThreadLevel(provided_level),
+                             ppc::util::GetStringMPIThreadLevel(required_level))
+              << '\n';
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    return EXIT_FAILURE;
+  }
+
+  // Split the node's cores between ranks before any worker thread is started
+  const ppc::util::ThreadPlacement placement(bind_mode, ppc::util::GetNumThreads());
 
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
@@ -178,6 +202,16 @@ int Init(int argc, char **argv) {
 }
 
 int SimpleInit(int argc, char **argv) {
+  ppc::util::BindMode bind_mode{};
+  try {
+    bind_mode = ppc::util::GetBindMode();
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    return EXIT_FAILURE;
+  }
+
+  const ppc::util::ThreadPlacement placement(bind_mode, ppc::util::GetNumThreads());
+
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
 
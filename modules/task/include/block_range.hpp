@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace ppc::task {
+
+/// @brief Half-open range [begin, end) of element indices.
+struct ChunkRange {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+
+  [[nodiscard]] std::size_t Size() const {
+    return end - begin;
+  }
+};
+
+/// @brief Returns the block of @p size elements owned by @p part out of @p parts (e.g. rank out of comm size).
+/// @details The first size % parts blocks get one extra element, matching the usual MPI_Scatterv split.
+inline ChunkRange GetBlockRange(std::size_t size, std::size_t part, std::size_t parts) {
+  if (parts == 0 || part >= parts) {
+    throw std::invalid_argument("Part index is out of range");
+  }
+  const std::size_t base = size / parts;
+  const std::size_t extra = size % parts;
+  const std::size_t begin = (part * base) + std::min(part, extra);
+  return {.begin = begin, .end = begin + base + (part < extra ? 1 : 0)};
+}
+
+}  // namespace ppc::task
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "task/include/block_range.hpp"
+
+namespace ppc::task {
+
+/// @brief Input that is read in chunks instead of being materialized as one container.
+/// @details The data comes from an in-memory or memory-mapped span, a generator or a raw binary file.
+/// Every process reads only the range it works on; at most chunk_size elements are buffered at a time,
+/// so inputs larger than one rank's memory can be reduced incrementally.
+/// @tparam T Trivially copyable element type.
+template <typename T>
+class ChunkedInput {
+  static_assert(std::is_trivially_copyable_v<T>, "ChunkedInput elements must be trivially copyable");
+
+ public:
+  /// @brief Fills the span with the elements starting at the given index.
+  using ChunkReader = std::function<void(std::size_t first, std::span<T> out)>;
+
+  static constexpr std::size_t kDefaultChunkSize = std::size_t{1} << 20;
+
+  ChunkedInput() = default;
+
+  /// @brief Wraps a reader that produces any requested range of @p size elements.
+  ChunkedInput(std::size_t size, ChunkReader reader, std::size_t chunk_size = kDefaultChunkSize)
+      : size_(size), chunk_size_(std::max<std::size_t>(chunk_size, 1)), reader_(std::move(reader)) {}
+
+  /// @brief Views caller-owned contiguous data (a vector, an mmap'ed file, ...) without copying it.
+  static ChunkedInput FromSpan(std::span<const T> data, std::size_t chunk_size = kDefaultChunkSize) {
+    ChunkedInput input;
+    input.size_ = data.size();
+    input.chunk_size_ = std::max<std::size_t>(chunk_size, 1);
+    input.data_ = data;
+    return input;
+  }
+
+  /// @brief Produces element i as generator(i); the data never exists as a whole.
+  static ChunkedInput FromGenerator(std::size_t size, std::function<T(std::size_t)> generator,
+                                    std::size_t chunk_size = kDefaultChunkSize) {
+    return ChunkedInput(size, [generator = std::move(generator)](std::size_t first, std::span<T> out) {
+      for (std::size_t i = 0; i < out.size(); i++) {
+        out[i] = generator(first + i);
+      }
+    }, chunk_size);
+  }
+
+  /// @brief Reads raw elements of type T from a binary file, starting at @p offset_bytes.
+  /// @throws std::runtime_error If the file cannot be opened or a read fails.
+  static ChunkedInput FromFile(const std::string &path, std::size_t offset_bytes = 0,
+                               std::size_t chunk_size = kDefaultChunkSize) {
+    auto stream = std::make_shared<std::ifstream>(path, std::ios::binary | std::ios::ate);
+    if (!stream->is_open()) {
+      throw std::runtime_error("Failed to open " + path);
+    }
+    const auto file_size = static_cast<std::size_t>(stream->tellg());
+    const std::size_t size = file_size > offset_bytes ? (file_size - offset_bytes) / sizeof(T) : 0;
+    return ChunkedInput(size, [stream, path, offset_bytes](std::size_t first, std::span<T> out) {
+      stream->clear();
+      stream->seekg(static_cast<std::streamoff>(offset_bytes + (first * sizeof(T))));
+      stream->read(reinterpret_cast<char *>(out.data()), static_cast<std::streamsize>(out.size_bytes()));
+      if (!*stream) {
+        throw std::runtime_error("Failed to read " + path);
+      }
+    }, chunk_size);
+  }
+
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+
+  [[nodiscard]] std::size_t ChunkSize() const {
+    return chunk_size_;
+  }
+
+  /// @brief Calls consumer(std::span<const T>) for consecutive chunks covering @p range.
+  /// @details Span sources are passed through without copying; other sources reuse one chunk buffer.
+  template <typename Consumer>
+  void ForEachChunk(ChunkRange range, Consumer &&consumer) const {
+    if (range.begin > range.end || range.end > size_) {
+      throw std::out_of_range("Chunk range is outside of the input");
+    }
+    if (!reader_) {
+      for (std::size_t first = range.begin; first < range.end; first += chunk_size_) {
+        consumer(data_.subspan(first, std::min(chunk_size_, range.end - first)));
+      }
+      return;
+    }
+    std::vector<T> buffer(std::min(chunk_size_, range.Size()));
+    for (std::size_t first = range.begin; first < range.end; first += chunk_size_) {
+      const std::span<T> chunk(buffer.data(), std::min(chunk_size_, range.end - first));
+      reader_(first, chunk);
+      consumer(std::span<const T>(chunk));
+    }
+  }
+
+  /// @brief Folds @p range chunk by chunk: acc = op(std::move(acc), chunk).
+  template <typename Acc, typename Op>
+  Acc Reduce(ChunkRange range, Acc init, Op &&op) const {
+    ForEachChunk(range, [&](std::span<const T> chunk) { init = op(std::move(init), chunk); });
+    return init;
+  }
+
+  /// @brief Copies @p range into a vector, e.g. the local part of a rank that fits into memory.
+  [[nodiscard]] std::vector<T> Materialize(ChunkRange range) const {
+    std::vector<T> result;
+    result.reserve(range.Size());
+    ForEachChunk(range, [&](std::span<const T> chunk) { result.insert(result.end(), chunk.begin(), chunk.end()); });
+    return result;
+  }
+
+ private:
+  std::size_t size_ = 0;
+  std::size_t chunk_size_ = kDefaultChunkSize;
+  std::span<const T> data_;
+  ChunkReader reader_;
+};
+
+}  // namespace ppc::task
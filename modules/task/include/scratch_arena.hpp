@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace ppc::task {
+
+/// @brief Allocation counters of a ScratchArena.
+struct ScratchStats {
+  /// @brief Allocations served by the arena.
+  uint64_t allocations = 0;
+  /// @brief Bytes requested from the arena.
+  uint64_t bytes = 0;
+  /// @brief Blocks the arena had to take from the heap; zero once the arena has warmed up.
+  uint64_t heap_allocations = 0;
+  /// @brief Bytes of those heap blocks.
+  uint64_t heap_bytes = 0;
+
+  ScratchStats &operator-=(const ScratchStats &other) {
+    allocations -= other.allocations;
+    bytes -= other.bytes;
+    heap_allocations -= other.heap_allocations;
+    heap_bytes -= other.heap_bytes;
+    return *this;
+  }
+
+  ScratchStats &operator+=(const ScratchStats &other) {
+    allocations += other.allocations;
+    bytes += other.bytes;
+    heap_allocations += other.heap_allocations;
+    heap_bytes += other.heap_bytes;
+    return *this;
+  }
+};
+
+/// @brief Memory resource for temporary buffers of one task, released all at once by Reset().
+/// @details Freed blocks are recycled by size class (std::pmr pool), and the pools carve their memory from one
+/// contiguous buffer. Whatever the buffer could not hold is taken from the heap and counted, and the arena
+/// remembers the largest buffer + heap footprint of any run as its high watermark. Neither Reset() nor
+/// allocation ever resize the buffer; Reserve() grows it to the watermark, so a caller that reserves between runs
+/// (Perf does, outside the measured time) keeps the hot path off the heap from the second run on.
+/// Blocks larger than the biggest pool size are only reclaimed by Reset().
+/// The arena is not thread-safe: allocate from it outside parallel regions or keep one arena per thread.
+class ScratchArena : public std::pmr::memory_resource {
+ public:
+  /// @param initial_capacity Size of the buffer allocated up front, in bytes.
+  explicit ScratchArena(std::size_t initial_capacity = 0)
+      : buffer_(AllocateBuffer(initial_capacity)), capacity_(initial_capacity) {
+    Rebuild();
+  }
+
+  ScratchArena(const ScratchArena &) = delete;
+  ScratchArena &operator=(const ScratchArena &) = delete;
+  ScratchArena(ScratchArena &&) = delete;
+  ScratchArena &operator=(ScratchArena &&) = delete;
+  ~ScratchArena() override = default;
+
+  /// @brief Frees every block allocated from the arena and clears the counters.
+  /// @details Containers that still use the arena must be destroyed before the call.
+  void Reset() {
+    UpdateHighWatermark();
+    Rebuild();
+  }
+
+  /// @brief Resets the arena and grows its buffer to at least @p capacity bytes and the high watermark.
+  /// @details Allocates only if the buffer is too small; the new buffer is left uninitialized. Call it where the
+  /// allocation is not measured, with no container still using the arena.
+  void Reserve(std::size_t capacity = 0) {
+    UpdateHighWatermark();
+    const std::size_t target = std::max(capacity, high_watermark_);
+    if (target > capacity_) {
+      // The pool keeps its bookkeeping in the buffer, so it has to go before the buffer is replaced
+      pool_.reset();
+      monotonic_.reset();
+      buffer_ = AllocateBuffer(target);
+      capacity_ = target;
+    }
+    Rebuild();
+  }
+
+  /// @brief Counters since the last Reset().
+  [[nodiscard]] ScratchStats GetStats() const {
+    return {.allocations = allocations_,
+            .bytes = bytes_,
+            .heap_allocations = upstream_.heap_allocations,
+            .heap_bytes = upstream_.heap_bytes};
+  }
+
+  /// @brief Size of the preallocated buffer in bytes.
+  [[nodiscard]] std::size_t Capacity() const {
+    return capacity_;
+  }
+
+  /// @brief Largest buffer + heap footprint of a run so far: the capacity Reserve() grows to.
+  /// @details The monotonic upstream asks the heap for geometrically growing blocks, so this may exceed the bytes
+  /// actually in use by up to that growth factor, but it does not add up across runs.
+  [[nodiscard]] std::size_t GetHighWatermark() const {
+    return std::max<std::size_t>(high_watermark_, capacity_ + upstream_.heap_bytes);
+  }
+
+ private:
+  /// @brief Heap resource that counts the blocks handed to the arena.
+  class CountingUpstream : public std::pmr::memory_resource {
+   public:
+    uint64_t heap_allocations = 0;
+    uint64_t heap_bytes = 0;
+
+   private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+      heap_allocations++;
+      heap_bytes += bytes;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+  };
+
+  static std::unique_ptr<std::byte[]> AllocateBuffer(std::size_t size) {
+    return size == 0 ? nullptr : std::make_unique_for_overwrite<std::byte[]>(size);
+  }
+
+  void UpdateHighWatermark() {
+    high_watermark_ = GetHighWatermark();
+  }
+
+  void Rebuild() {
+    pool_.reset();
+    monotonic_.reset();
+    upstream_.heap_allocations = 0;
+    upstream_.heap_bytes = 0;
+    allocations_ = 0;
+    bytes_ = 0;
+    if (capacity_ == 0) {
+      monotonic_.emplace(&upstream_);
+    } else {
+      monotonic_.emplace(buffer_.get(), capacity_, &upstream_);
+    }
+    pool_.emplace(std::pmr::pool_options{.max_blocks_per_chunk = 0, .largest_required_pool_block = kLargestPoolBlock},
+                  &*monotonic_);
+  }
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    allocations_++;
+    bytes_ += bytes;
+    return pool_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+    pool_->deallocate(p, bytes, alignment);
+  }
+
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  static constexpr std::size_t kLargestPoolBlock = std::size_t{1} << 20;
+
+  std::unique_ptr<std::byte[]> buffer_;
+  std::size_t capacity_ = 0;
+  std::size_t high_watermark_ = 0;
+  CountingUpstream upstream_;
+  std::optional<std::pmr::monotonic_buffer_resource> monotonic_;
+  std::optional<std::pmr::unsynchronized_pool_resource> pool_;
+  uint64_t allocations_ = 0;
+  uint64_t bytes_ = 0;
+};
+
+/// @brief Vector whose storage comes from a ScratchArena: ScratchVector<int> tmp(n, 0, &GetScratchArena()).
+template <typename T>
+using ScratchVector = std::vector<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace ppc::task
@@ -4,6 +4,7 @@
 
 #include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
@@ -16,6 +17,8 @@
 #include <util/include/util.hpp>
 #include <utility>
 
+#include "task/include/scratch_arena.hpp"
+
 namespace ppc::task {
 
 /// @brief Represents the type of task (parallelization technology).
@@ -56,6 +59,26 @@ inline std::string TypeOfTaskToString(TypeOfTask type) {
   return "unknown";
 }
 
+/// @brief Describes which MPI processes need the task input.
+enum class InputResidency : uint8_t {
+  /// Every process gets the full input
+  kAllRanks,
+  /// Only kInputRootRank gets the input, other processes of an MPI task get an empty InType
+  kRootOnly,
+};
+
+/// @brief Rank that holds the input of kRootOnly tasks.
+inline constexpr int kInputRootRank = 0;
+
+/// @brief Returns true if a task of the given type and residency needs its input on the calling process.
+inline bool IsInputResident(TypeOfTask type_of_task, InputResidency residency) {
+  if (residency == InputResidency::kAllRanks ||
+      (type_of_task != TypeOfTask::kMPI && type_of_task != TypeOfTask::kALL)) {
+    return true;
+  }
+  return ppc::util::GetMPIRank() == kInputRootRank;
+}
+
 /// @brief Indicates whether a task is enabled or disabled.
 enum class StatusOfTask : uint8_t {
   /// Task is enabled and should be executed
@@ -101,6 +124,40 @@ enum class StateOfTesting : uint8_t {
   kPerf,
 };
 
+/// @brief Stages of the task pipeline, in execution order.
+enum class TaskStage : uint8_t {
+  kValidation,
+  kPreProcessing,
+  kRun,
+  kPostProcessing,
+};
+
+inline constexpr std::size_t kNumTaskStages = 4;
+
+/// @brief Returns a string representation of the pipeline stage.
+inline std::string GetStringTaskStage(TaskStage stage) {
+  switch (stage) {
+    case TaskStage::kValidation:
+      return "validation";
+    case TaskStage::kPreProcessing:
+      return "pre_processing";
+    case TaskStage::kRun:
+      return "run";
+    case TaskStage::kPostProcessing:
+      return "post_processing";
+  }
+  return "unknown";
+}
+
+/// @brief Accumulated wall time and number of calls of one pipeline stage.
+struct StageTiming {
+  double time_sec = 0.0;
+  uint64_t calls = 0;
+};
+
+/// @brief Stage timings indexed by TaskStage.
+using StageTimings = std::array<StageTiming, kNumTaskStages>;
+
 template <typename InType, typename OutType>
 /// @brief Base abstract class representing a generic task with a defined pipeline.
 /// @tparam InType Input data type.
@@ -116,7 +173,9 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Validation should be called before preprocessing");
     }
-    return ValidationImpl();
+    scratch_arena_.Reset();
+    run_scratch_stats_ = {};
+    return TimeStage(TaskStage::kValidation, [this] { return ValidationImpl(); });
   }
 
   /// @brief Performs preprocessing on the input data.
@@ -131,7 +190,7 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PreProcessingImpl();
+    return TimeStage(TaskStage::kPreProcessing, [this] { return PreProcessingImpl(); });
   }
 
   /// @brief Executes the main logic of the task.
@@ -143,7 +202,12 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Run should be called after preprocessing");
     }
-    return RunImpl();
+    auto run_scratch_stats = scratch_arena_.GetStats();
+    const bool result = TimeStage(TaskStage::kRun, [this] { return RunImpl(); });
+    auto after_run = scratch_arena_.GetStats();
+    after_run -= run_scratch_stats;
+    run_scratch_stats_ += after_run;
+    return result;
   }
 
   /// @brief Performs postprocessing on the output data.
@@ -158,7 +222,7 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PostProcessingImpl();
+    return TimeStage(TaskStage::kPostProcessing, [this] { return PostProcessingImpl(); });
   }
 
   /// @brief Returns the current testing mode.
@@ -191,6 +255,85 @@ class Task {
     return TypeOfTask::kUnknown;
   }
 
+  /// @brief Returns where the task needs its input; tasks that only read it on kInputRootRank return kRootOnly.
+  /// @return Static input residency (default: kAllRanks).
+  static constexpr InputResidency GetStaticInputResidency() {
+    return InputResidency::kAllRanks;
+  }
+
+  /// @brief Returns the wall time spent in each pipeline stage since the last ResetStageTimings().
+  [[nodiscard]] const StageTimings &GetStageTimings() const {
+    return stage_timings_;
+  }
+
+  /// @brief Clears the accumulated stage timings.
+  void ResetStageTimings() {
+    stage_timings_ = {};
+  }
+
+  /// @brief Returns the arena for temporary buffers of the implementation.
+  /// @details The arena is reset at the start of every pipeline, so scratch containers must not outlive
+  /// PostProcessingImpl(). Use it for per-iteration buffers on hot paths, e.g.
+  /// ppc::task::ScratchVector<int> tmp(n, 0, &GetScratchArena()).
+  ScratchArena &GetScratchArena() {
+    return scratch_arena_;
+  }
+
+  /// @brief Grows the scratch arena to the largest footprint of a pipeline run so far.
+  /// @details Perf calls it before every iteration, outside the measured time, so the arena never reallocates
+  /// inside a timed pipeline. Must not be called while the pipeline is running.
+  void ReserveScratch() {
+    CheckPipelineIdle("ReserveScratch");
+    scratch_arena_.Reserve();
+  }
+
+  /// @brief Returns the scratch allocations made by Run() in the current pipeline.
+  [[nodiscard]] const ScratchStats &GetRunScratchStats() const {
+    return run_scratch_stats_;
+  }
+
+  /// @brief Saves a copy of the current input that RestoreInput() brings back.
+  /// @details Lets PreProcessingImpl() consume GetInput() (e.g. move from it) and still run the pipeline again;
+  /// Perf restores the snapshot between timed iterations, outside the measured time.
+  /// @note The snapshot is a second full copy of the input, so an opted-in task holds twice its input size for
+  /// as long as the snapshot lives; root-only or chunked inputs should not take one.
+  void SnapshotInput() {
+    input_snapshot_ = std::make_unique<InType>(input_);
+  }
+
+  /// @brief Returns true if SnapshotInput() was called for the current input.
+  [[nodiscard]] bool HasInputSnapshot() const {
+    return input_snapshot_ != nullptr;
+  }
+
+  /// @brief Copies the snapshot back into the input; does nothing without a snapshot.
+  /// @details Assigns into the existing input, so a consumed container that kept its capacity is refilled in place.
+  void RestoreInput() {
+    if (input_snapshot_ != nullptr) {
+      input_ = *input_snapshot_;
+    }
+  }
+
+  /// @brief Prepares a finished task for another pipeline run: restores the input snapshot and clears the output.
+  /// @throws std::runtime_error If the pipeline is in progress.
+  void Reset() {
+    CheckPipelineIdle("Reset");
+    RestoreInput();
+    output_ = OutType{};
+  }
+
+  /// @brief Replaces the input of a finished task, so one task object can be benchmarked on several inputs.
+  /// @details An existing snapshot is retaken for the new input; the output is cleared.
+  /// @throws std::runtime_error If the pipeline is in progress.
+  void Rebind(InType in) {
+    CheckPipelineIdle("Rebind");
+    input_ = std::move(in);
+    if (input_snapshot_ != nullptr) {
+      SnapshotInput();
+    }
+    output_ = OutType{};
+  }
+
   /// @brief Returns a reference to the input data.
   /// @return Reference to the task's input data.
   InType &GetInput() {
@@ -258,12 +401,34 @@ class Task {
   virtual bool PostProcessingImpl() = 0;
 
  private:
+  void CheckPipelineIdle(const std::string &operation) const {
+    if (stage_ != PipelineStage::kNone && stage_ != PipelineStage::kDone) {
+      throw std::runtime_error(operation + " should be called before validation or after postprocessing");
+    }
+  }
+
+  /// @brief Runs a stage implementation and adds its wall time to the stage's timing.
+  template <typename StageImpl>
+  bool TimeStage(TaskStage stage, StageImpl &&impl) {
+    const auto begin = std::chrono::high_resolution_clock::now();
+    const bool result = std::forward<StageImpl>(impl)();
+    const auto end = std::chrono::high_resolution_clock::now();
+    auto &timing = stage_timings_[static_cast<std::size_t>(stage)];
+    timing.time_sec += std::chrono::duration<double>(end - begin).count();
+    timing.calls++;
+    return result;
+  }
+
   InType input_{};
+  std::unique_ptr<InType> input_snapshot_;
   OutType output_{};
   StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
   TypeOfTask type_of_task_ = TypeOfTask::kUnknown;
   StatusOfTask status_of_task_ = StatusOfTask::kEnabled;
   std::chrono::high_resolution_clock::time_point tmp_time_point_;
+  StageTimings stage_timings_{};
+  ScratchArena scratch_arena_;
+  ScratchStats run_scratch_stats_{};
   enum class PipelineStage : uint8_t {
     kNone,
     kValidation,
@@ -281,13 +446,15 @@ template <typename InType, typename OutType>
 using TaskPtr = std::shared_ptr<Task<InType, OutType>>;
 
 /// @brief Constructs and returns a shared pointer to a task with the given input.
+/// @details The input is taken by value and moved on, so a task whose constructor accepts InType by value
+/// (or by rvalue reference) receives the caller's buffer without another copy.
 /// @tparam TaskType Type of the task to create.
 /// @tparam InType Type of the input.
 /// @param in Input to pass to the task constructor.
 /// @return Shared a pointer to the newly created task.
 template <typename TaskType, typename InType>
-std::shared_ptr<TaskType> TaskGetter(const InType &in) {
-  return std::make_shared<TaskType>(in);
+std::shared_ptr<TaskType> TaskGetter(InType in) {
+  return std::make_shared<TaskType>(std::move(in));
 }
 
 }  // namespace ppc::task
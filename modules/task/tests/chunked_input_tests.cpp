@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "task/include/chunked_input.hpp"
+
+using ppc::task::ChunkedInput;
+using ppc::task::ChunkRange;
+using ppc::task::GetBlockRange;
+
+TEST(ChunkedInputTest, BlockRangesCoverInputLikeScatterv) {
+  std::size_t next = 0;
+  for (std::size_t part = 0; part < 3; part++) {
+    const auto range = GetBlockRange(10, part, 3);
+    EXPECT_EQ(range.begin, next);
+    EXPECT_EQ(range.Size(), part == 0 ? 4U : 3U);
+    next = range.end;
+  }
+  EXPECT_EQ(next, 10U);
+  EXPECT_EQ(GetBlockRange(2, 3, 4).Size(), 0U);
+  EXPECT_THROW(GetBlockRange(10, 3, 3), std::invalid_argument);
+}
+
+TEST(ChunkedInputTest, SpanSourceIsPassedWithoutCopies) {
+  std::vector<int> data(10);
+  std::iota(data.begin(), data.end(), 0);
+  const auto input = ChunkedInput<int>::FromSpan(data, 4);
+
+  std::vector<std::size_t> chunk_sizes;
+  input.ForEachChunk({.begin = 1, .end = 10}, [&](std::span<const int> chunk) {
+    EXPECT_GE(chunk.data(), data.data());
+    EXPECT_LT(chunk.data(), data.data() + data.size());
+    chunk_sizes.push_back(chunk.size());
+  });
+  EXPECT_EQ(chunk_sizes, (std::vector<std::size_t>{4, 4, 1}));
+  EXPECT_THROW(input.ForEachChunk({.begin = 0, .end = 11}, [](std::span<const int>) {}), std::out_of_range);
+}
+
+TEST(ChunkedInputTest, GeneratorSourceReducesIncrementally) {
+  const auto input = ChunkedInput<int64_t>::FromGenerator(
+      1000, [](std::size_t i) { return static_cast<int64_t>(i) + 1; }, 64);
+  auto sum_chunk = [](int64_t acc, std::span<const int64_t> chunk) {
+    return std::accumulate(chunk.begin(), chunk.end(), acc);
+  };
+  int64_t total = 0;
+  for (std::size_t part = 0; part < 4; part++) {
+    total += input.Reduce(GetBlockRange(input.Size(), part, 4), int64_t{0}, sum_chunk);
+  }
+  EXPECT_EQ(total, 1000 * 1001 / 2);
+  EXPECT_EQ(input.Materialize({.begin = 998, .end = 1000}), (std::vector<int64_t>{999, 1000}));
+}
+
+TEST(ChunkedInputTest, FileSourceReadsRequestedRange) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_chunked_input_test.bin").string();
+  std::vector<double> data(100);
+  std::iota(data.begin(), data.end(), 0.5);
+  {
+    std::ofstream file(path, std::ios::binary);
+    const std::int32_t header = 42;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(double)));
+  }
+
+  const auto input = ChunkedInput<double>::FromFile(path, sizeof(std::int32_t), 7);
+  EXPECT_EQ(input.Size(), data.size());
+  EXPECT_EQ(input.Materialize({.begin = 10, .end = 30}), std::vector<double>(data.begin() + 10, data.begin() + 30));
+  std::filesystem::remove(path);
+
+  EXPECT_THROW(ChunkedInput<double>::FromFile(path), std::runtime_error);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "task/include/scratch_arena.hpp"
+#include "task/include/task.hpp"
+
+using ppc::task::ScratchArena;
+using ppc::task::ScratchVector;
+
+TEST(ScratchArenaTest, CountsAllocationsAndRecyclesFreedBlocks) {
+  ScratchArena arena;
+  const int *first_data = nullptr;
+  {
+    ScratchVector<int> tmp(100, 1, &arena);
+    first_data = tmp.data();
+  }
+  ScratchVector<int> tmp(100, 2, &arena);
+  EXPECT_EQ(tmp.data(), first_data);
+
+  const auto stats = arena.GetStats();
+  EXPECT_EQ(stats.allocations, 2U);
+  EXPECT_EQ(stats.bytes, 2 * 100 * sizeof(int));
+  EXPECT_GT(stats.heap_allocations, 0U);
+}
+
+TEST(ScratchArenaTest, ReserveGrowsBufferSoNextRunAvoidsHeap) {
+  ScratchArena arena;
+  auto run = [&arena] {
+    for (std::size_t n = 1; n < 200; n++) {
+      ScratchVector<double> tmp(n, 1.0, &arena);
+      ScratchVector<int64_t> other(2 * n, 1, &arena);
+    }
+  };
+  run();
+  EXPECT_GT(arena.GetStats().heap_allocations, 0U);
+  arena.Reset();
+  EXPECT_EQ(arena.Capacity(), 0U);
+  EXPECT_EQ(arena.GetStats().allocations, 0U);
+  arena.Reserve();
+  EXPECT_GT(arena.Capacity(), 0U);
+
+  run();
+  EXPECT_EQ(arena.GetStats().allocations, 2U * 199U);
+  EXPECT_EQ(arena.GetStats().heap_allocations, 0U);
+}
+
+TEST(ScratchArenaTest, RepeatedSpillsDoNotGrowBeyondTheWatermark) {
+  ScratchArena arena;
+  auto spill = [&arena] { ScratchVector<std::byte> big(std::size_t{4} << 20, std::byte{1}, &arena); };
+  spill();
+  arena.Reset();
+  const std::size_t watermark = arena.GetHighWatermark();
+  EXPECT_GE(watermark, std::size_t{4} << 20);
+
+  // Without Reserve() every run spills the same amount; the watermark is the peak, not the sum
+  for (int i = 0; i < 3; i++) {
+    spill();
+    arena.Reset();
+    EXPECT_EQ(arena.GetHighWatermark(), watermark);
+  }
+  EXPECT_EQ(arena.Capacity(), 0U);
+  arena.Reserve();
+  EXPECT_EQ(arena.Capacity(), watermark);
+  spill();
+  EXPECT_EQ(arena.GetStats().heap_allocations, 0U);
+  arena.Reserve();
+  EXPECT_EQ(arena.Capacity(), watermark);
+}
+
+namespace {
+
+class ScratchTask : public ppc::task::Task<int, int> {
+ public:
+  explicit ScratchTask(int in) {
+    GetInput() = in;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return GetInput() > 0;
+  }
+  bool PreProcessingImpl() override {
+    ScratchVector<int> warmup(1, 0, &GetScratchArena());
+    return true;
+  }
+  bool RunImpl() override {
+    GetOutput() = 0;
+    for (int i = 1; i <= GetInput(); i++) {
+      ScratchVector<int> tmp(static_cast<std::size_t>(i), 1, &GetScratchArena());
+      GetOutput() += std::accumulate(tmp.begin(), tmp.end(), 0);
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+bool RunPipeline(ScratchTask &task) {
+  return task.Validation() && task.PreProcessing() && task.Run() && task.PostProcessing();
+}
+
+}  // namespace
+
+TEST(ScratchArenaTest, TaskCountsRunAllocationsAndResetsArenaPerPipeline) {
+  ScratchTask task(64);
+  ASSERT_TRUE(RunPipeline(task));
+  EXPECT_EQ(task.GetOutput(), 64 * 65 / 2);
+  EXPECT_EQ(task.GetRunScratchStats().allocations, 64U);
+  EXPECT_EQ(task.GetScratchArena().GetStats().allocations, 65U);
+
+  task.ReserveScratch();
+  ASSERT_TRUE(RunPipeline(task));
+  EXPECT_EQ(task.GetRunScratchStats().allocations, 64U);
+  EXPECT_EQ(task.GetRunScratchStats().heap_allocations, 0U);
+}
@@ -6,6 +6,7 @@
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <libenvpp/env.hpp>
 #include <memory>
 #include <stdexcept>
@@ -352,6 +353,58 @@ TEST(TaskTest, PostProcessingThrowsIfCalledBeforeRun) {
   EXPECT_THROW(task->PostProcessing(), std::runtime_error);
 }
 
+class ByValueInputTask : public Task<std::vector<int>, int> {
+ public:
+  explicit ByValueInputTask(std::vector<int> in) {
+    GetInput() = std::move(in);
+  }
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+TEST(TaskTest, TaskGetterMovesInputIntoTask) {
+  std::vector<int> in(1024, 1);
+  const int *buffer = in.data();
+  auto task = ppc::task::TaskGetter<ByValueInputTask>(std::move(in));
+  EXPECT_EQ(task->GetInput().data(), buffer);
+
+  std::function<ppc::task::TaskPtr<std::vector<int>, int>(std::vector<int>)> getter =
+      ppc::task::TaskGetter<ByValueInputTask, std::vector<int>>;
+  std::vector<int> other(16, 2);
+  const int *other_buffer = other.data();
+  auto other_task = getter(std::move(other));
+  EXPECT_EQ(other_task->GetInput().data(), other_buffer);
+
+  for (const auto &t : {ppc::task::TaskPtr<std::vector<int>, int>(task), other_task}) {
+    t->Validation();
+    t->PreProcessing();
+    t->Run();
+    t->PostProcessing();
+  }
+}
+
+TEST(TaskTest, InputIsResidentEverywhereUnlessRootOnlyMpiTask) {
+  using ppc::task::InputResidency;
+  EXPECT_EQ(DummyTask::GetStaticInputResidency(), InputResidency::kAllRanks);
+  EXPECT_TRUE(ppc::task::IsInputResident(TypeOfTask::kMPI, InputResidency::kAllRanks));
+  EXPECT_TRUE(ppc::task::IsInputResident(TypeOfTask::kSEQ, InputResidency::kRootOnly));
+  EXPECT_TRUE(ppc::task::IsInputResident(TypeOfTask::kOMP, InputResidency::kRootOnly));
+}
+
 int main(int argc, char **argv) {
+  // Under mpirun the MpiRun* tests of modules/mpi exchange messages, so MPI has to be up
+  if (ppc::util::IsUnderMpirun()) {
+    return ppc::runners::Init(argc, argv);
+  }
   return ppc::runners::SimpleInit(argc, argv);
 }
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief Runs MPI communication on a helper thread so the calling thread can compute meanwhile.
+/// @details Requires MPI_THREAD_SERIALIZED or better (PPC_MPI_THREAD_LEVEL=serialized|multiple).
+/// With kSerialized the calling thread must not call MPI until Wait() returns; with kMultiple both
+/// threads may communicate, e.g. a halo exchange in the background while the interior is updated.
+class CommThread {
+ public:
+  /// @brief Starts @p communication on a new thread.
+  /// @throws std::runtime_error If the provided MPI thread level is below kSerialized.
+  template <typename Communication>
+  explicit CommThread(Communication &&communication) {
+    if (const auto level = GetMPIThreadLevel(); level < MPIThreadLevel::kSerialized) {
+      throw std::runtime_error("CommThread needs MPI thread level 'serialized' or 'multiple', MPI provides '" +
+                               GetStringMPIThreadLevel(level) + "'; set PPC_MPI_THREAD_LEVEL");
+    }
+    result_ = std::async(std::launch::async, std::forward<Communication>(communication));
+  }
+
+  CommThread(const CommThread &) = delete;
+  CommThread &operator=(const CommThread &) = delete;
+  CommThread(CommThread &&) = default;
+  CommThread &operator=(CommThread &&) = default;
+
+  /// @brief Joins the thread if Wait() was not called; exceptions of the communication are dropped.
+  ~CommThread() {
+    if (result_.valid()) {
+      result_.wait();
+    }
+  }
+
+  /// @brief Returns true once the communication has finished.
+  [[nodiscard]] bool IsDone() const {
+    return !result_.valid() || result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+  /// @brief Blocks until the communication has finished and rethrows its exception, if any.
+  void Wait() {
+    if (result_.valid()) {
+      result_.get();
+    }
+  }
+
+ private:
+  std::future<void> result_;
+};
+
+}  // namespace ppc::util
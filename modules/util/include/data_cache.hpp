@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "util/include/dataset.hpp"
+
+namespace ppc::util {
+
+/// @brief Identifies a generated input: the same key always has to produce the same data.
+struct DataCacheKey {
+  /// Task namespace, e.g. "shkryleva_s_vec_min_val"
+  std::string task_id;
+  /// Generator name; bump a version suffix when the generator changes
+  std::string generator;
+  std::vector<std::size_t> shape;
+  uint64_t seed = 0;
+};
+
+/// @brief Directory of cached inputs: PPC_DATA_CACHE_DIR or "ppc_data_cache" in the system temp directory.
+std::string GetDataCacheDir();
+
+/// @brief Path of the dataset file that stores the data for @p key.
+std::string GetDataCachePath(const DataCacheKey &key, DType dtype);
+
+/// @brief Maps the cached dataset for @p key, calling @p write_dataset(path) to create it if missing.
+/// @details One process per cache directory generates the file under a lock; concurrent processes
+/// (e.g. sibling MPI ranks) wait for it, and later runs map it directly. The file appears atomically.
+MappedDataset GetOrCreateCachedDataset(const DataCacheKey &key, DType dtype,
+                                       const std::function<void(const std::string &)> &write_dataset);
+
+/// @brief Typed variant: @p generate fills a buffer with key.shape elements on a cache miss.
+template <typename T>
+MappedDataset GetOrCreateCachedDataset(const DataCacheKey &key, const std::function<void(std::span<T>)> &generate) {
+  return GetOrCreateCachedDataset(key, GetDType<T>(), [&](const std::string &path) {
+    const auto size = std::accumulate(key.shape.begin(), key.shape.end(), std::size_t{1}, std::multiplies<>());
+    std::vector<T> data(size);
+    generate(data);
+    WriteDataset<T>(path, data, key.shape);
+  });
+}
+
+}  // namespace ppc::util
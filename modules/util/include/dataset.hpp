@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Element type stored in a dataset file.
+enum class DType : uint32_t {
+  kInt8,
+  kUInt8,
+  kInt32,
+  kUInt32,
+  kInt64,
+  kUInt64,
+  kFloat32,
+  kFloat64,
+};
+
+/// @brief Size of one element of the given type in bytes.
+std::size_t GetDTypeSize(DType dtype);
+
+template <typename T>
+constexpr DType GetDType() {
+  if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, char>) {
+    return DType::kInt8;
+  } else if constexpr (std::is_same_v<T, uint8_t>) {
+    return DType::kUInt8;
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return DType::kInt32;
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    return DType::kUInt32;
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return DType::kInt64;
+  } else if constexpr (std::is_same_v<T, uint64_t>) {
+    return DType::kUInt64;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return DType::kFloat32;
+  } else {
+    static_assert(std::is_same_v<T, double>, "Unsupported dataset element type");
+    return DType::kFloat64;
+  }
+}
+
+/// @brief Maximum number of dimensions a dataset can have.
+inline constexpr std::size_t kDatasetMaxDims = 12;
+
+/// @brief Writes a dataset file: a fixed 128-byte header (magic, dtype, shape) followed by the raw payload
+/// in native byte order. The payload offset keeps it aligned for any element type when mapped.
+/// @param shape Dimensions; their product must equal the number of elements in @p payload. An empty shape is a
+/// scalar and holds exactly one element.
+/// @throws std::runtime_error If the file cannot be written or the shape does not match the payload.
+void WriteDataset(const std::string &path, DType dtype, const std::vector<std::size_t> &shape,
+                  std::span<const std::byte> payload);
+
+template <typename T>
+void WriteDataset(const std::string &path, std::span<const T> data, std::vector<std::size_t> shape = {}) {
+  if (shape.empty()) {
+    shape.push_back(data.size());
+  }
+  WriteDataset(path, GetDType<T>(), shape, std::as_bytes(data));
+}
+
+/// @brief Read-only view of a dataset file mapped into memory.
+/// @details The payload is not copied: opening is O(1) and processes on one node share the page cache.
+class MappedDataset {
+ public:
+  /// @throws std::runtime_error If the file cannot be opened or is not a valid dataset.
+  explicit MappedDataset(const std::string &path);
+  ~MappedDataset();
+
+  MappedDataset(const MappedDataset &) = delete;
+  MappedDataset &operator=(const MappedDataset &) = delete;
+  MappedDataset(MappedDataset &&other) noexcept;
+  MappedDataset &operator=(MappedDataset &&other) noexcept;
+
+  [[nodiscard]] DType GetDType() const {
+    return dtype_;
+  }
+
+  [[nodiscard]] const std::vector<std::size_t> &GetShape() const {
+    return shape_;
+  }
+
+  /// @brief Returns the product of the shape: 1 for a scalar (empty shape), 0 if any dimension is 0.
+  [[nodiscard]] std::size_t GetNumElements() const;
+
+  /// @brief Returns the payload as elements of type T.
+  /// @throws std::runtime_error If T does not match the stored element type.
+  template <typename T>
+  [[nodiscard]] std::span<const T> View() const {
+    if (ppc::util::GetDType<T>() != dtype_) {
+      throw std::runtime_error("Dataset element type mismatch");
+    }
+    return {reinterpret_cast<const T *>(payload_), GetNumElements()};
+  }
+
+ private:
+  void Release();
+
+  DType dtype_ = DType::kUInt8;
+  std::vector<std::size_t> shape_;
+  const std::byte *payload_ = nullptr;
+  void *mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  std::vector<std::byte> fallback_buffer_;
+};
+
+}  // namespace ppc::util
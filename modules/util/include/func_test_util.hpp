@@ -19,7 +19,8 @@
 namespace ppc::util {
 
 template <typename InType, typename OutType, typename TestType = void>
-using FuncTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string, TestType>;
+using FuncTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string, TestType,
+                                 ppc::task::TypeOfTask, ppc::task::InputResidency>;
 
 template <typename InType, typename OutType, typename TestType = void>
 using GTestFuncParam = ::testing::TestParamInfo<FuncTestParam<InType, OutType, TestType>>;
@@ -93,7 +94,11 @@ class BaseRunFuncTests : public ::testing::TestWithParam<FuncTestParam<InType, O
 
   /// @brief Initializes task instance and runs it through the full pipeline.
   void InitializeAndRunTask(const FuncTestParam<InType, OutType, TestType> &test_param) {
-    task_ = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(test_param)(GetTestInputData());
+    const auto type_of_task = std::get<static_cast<std::size_t>(GTestParamIndex::kTypeOfTask)>(test_param);
+    const auto residency = std::get<static_cast<std::size_t>(GTestParamIndex::kInputResidency)>(test_param);
+    // Processes that do not hold the input of a root-only task never ask the fixture for it
+    auto input = ppc::task::IsInputResident(type_of_task, residency) ? GetTestInputData() : InType{};
+    task_ = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(test_param)(std::move(input));
     ExecuteTaskPipeline();
   }
 
@@ -128,7 +133,7 @@ auto GenTaskTuplesImpl(const SizesContainer &sizes, const std::string &settings_
   return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<Task, InType>,
                                          std::string(GetNamespace<Task>()) + "_" +
                                              ppc::task::GetStringTaskType(Task::GetStaticTypeOfTask(), settings_path),
-                                         sizes[Is])...);
+                                         sizes[Is], Task::GetStaticTypeOfTask(), Task::GetStaticInputResidency())...);
 }
 
 template <typename Task, typename InType, typename SizesContainer>
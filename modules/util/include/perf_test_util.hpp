@@ -6,26 +6,61 @@
 #include <chrono>
 #include <csignal>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "mpi/include/comm_cache.hpp"
 #include "performance/include/performance.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
 
+#ifdef PPC_USE_MPI_PROFILER
+#  include "mpi_profiler/include/mpi_profiler.hpp"
+#endif
+
+#ifdef PPC_USE_ALLOC_TRACKER
+#  include "performance/include/alloc_tracker.hpp"
+#endif
+
 namespace ppc::util {
 
 double GetTimeMPI();
-int GetMPIRank();
+/// @brief Returns rank 0's decision on every rank of MPI_COMM_WORLD.
+bool BroadcastDecisionMPI(bool local_decision);
+/// @brief Gathers one value per rank of MPI_COMM_WORLD on rank 0.
+/// @return Values indexed by rank on rank 0, an empty vector on other ranks.
+std::vector<double> GatherToRootMPI(double local_value);
 
 template <typename InType, typename OutType>
 using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string,
-                                 ppc::performance::PerfResults::TypeOfRunning>;
+                                 ppc::performance::PerfResults::TypeOfRunning, ppc::task::TypeOfTask,
+                                 ppc::task::InputResidency>;
+
+/// @brief Number of workers a task of the given type runs on: MPI processes, threads or both.
+inline std::size_t GetNumWorkers(ppc::task::TypeOfTask type_of_task) {
+  switch (type_of_task) {
+    case ppc::task::TypeOfTask::kMPI:
+      return static_cast<std::size_t>(GetMPISize());
+    case ppc::task::TypeOfTask::kALL:
+      return static_cast<std::size_t>(GetMPISize()) * static_cast<std::size_t>(GetNumThreads());
+    case ppc::task::TypeOfTask::kOMP:
+    case ppc::task::TypeOfTask::kSTL:
+    case ppc::task::TypeOfTask::kTBB:
+      return static_cast<std::size_t>(GetNumThreads());
+    case ppc::task::TypeOfTask::kSEQ:
+    case ppc::task::TypeOfTask::kUnknown:
+      return 1;
+  }
+  return 1;
+}
 
 template <typename InType, typename OutType>
 /// @brief Base class for performance testing of parallel tasks.
@@ -45,11 +80,21 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
   /// @brief Supplies input data for performance testing.
   virtual InType GetTestInputData() = 0;
 
+  /// @brief Default amount of work per worker for weak-scaling runs (PPC_PERF_WEAK_SCALING=1).
+  /// @return Zero if the task does not support weak scaling.
+  virtual std::size_t GetWeakScalingSizePerWorker() {
+    return 0;
+  }
+  /// @brief Rebuilds the test input (and the expected output) for @p num_workers workers with
+  /// @p size_per_worker units of work each; GetTestInputData() must return the new input afterwards.
+  virtual void SetUpWeakScaling(std::size_t /*size_per_worker*/, std::size_t /*num_workers*/) {}
+
   virtual void SetPerfAttributes(ppc::performance::PerfAttr &perf_attrs) {
     if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
         task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL) {
       const double t0 = GetTimeMPI();
       perf_attrs.current_timer = [t0] { return GetTimeMPI() - t0; };
+      perf_attrs.stop_consensus = BroadcastDecisionMPI;
     } else if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kOMP) {
       const double t0 = omp_get_wtime();
       perf_attrs.current_timer = [t0] { return omp_get_wtime() - t0; };
@@ -71,6 +116,8 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
     auto task_getter = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(perf_test_param);
     auto test_name = std::get<static_cast<std::size_t>(GTestParamIndex::kNameTest)>(perf_test_param);
     auto mode = std::get<static_cast<std::size_t>(GTestParamIndex::kTestParams)>(perf_test_param);
+    auto type_of_task = std::get<static_cast<std::size_t>(GTestParamIndex::kTypeOfTask)>(perf_test_param);
+    auto residency = std::get<static_cast<std::size_t>(GTestParamIndex::kInputResidency)>(perf_test_param);
 
     ASSERT_FALSE(test_name.find("unknown") != std::string::npos);
     if (test_name.find("disabled") != std::string::npos) {
@@ -79,9 +126,37 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
 
     const auto test_env_scope = ppc::util::test::MakePerTestEnvForCurrentGTest(test_name);
 
-    task_ = task_getter(GetTestInputData());
+    std::size_t size_per_worker = 0;
+    std::size_t num_workers = 0;
+    if (GetPerfWeakScaling()) {
+      size_per_worker = GetWeakScalingSizePerWorker();
+      if (size_per_worker == 0) {
+        GTEST_SKIP() << "The task does not describe its input for weak scaling.";
+      }
+      if (const std::size_t override_size = GetPerfSizePerWorker(); override_size > 0) {
+        size_per_worker = override_size;
+      }
+      num_workers = GetNumWorkers(type_of_task);
+      SetUpWeakScaling(size_per_worker, num_workers);
+    }
+
+#ifdef PPC_USE_MPI_PROFILER
+    ppc::mpi_profiler::Start();
+#endif
+
+    // Processes that do not hold the input of a root-only task never ask the fixture for it
+    task_ = task_getter(ppc::task::IsInputResident(type_of_task, residency) ? GetTestInputData() : InType{});
     ppc::performance::Perf perf(task_);
     ppc::performance::PerfAttr perf_attr;
+    perf_attr.num_warmup = static_cast<uint64_t>(GetPerfNumWarmup());
+    perf_attr.collect_hw_counters = GetPerfHwCounters();
+    if (const double target_ci = GetPerfTargetRelativeCI(); target_ci > 0.0) {
+      perf_attr.iteration_policy = ppc::performance::IterationPolicy::kAdaptive;
+      perf_attr.target_relative_ci = target_ci;
+    }
+#ifdef PPC_USE_ALLOC_TRACKER
+    perf_attr.track_allocations = true;
+#endif
     SetPerfAttributes(perf_attr);
 
     if (mode == ppc::performance::PerfResults::TypeOfRunning::kPipeline) {
@@ -94,15 +169,70 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
       throw std::runtime_error(err_msg.str().c_str());
     }
 
+#ifdef PPC_USE_MPI_PROFILER
+    // Stopped before any of the harness's own gathers, which would otherwise show up in the task's profile
+    ppc::mpi_profiler::Stop();
+#endif
+
+#ifdef PPC_USE_ALLOC_TRACKER
+    const auto alloc_stats = ppc::performance::alloc_tracker::GatherStats();
+    perf.AddRecordSection("allocations", ppc::performance::alloc_tracker::StatsToJson(alloc_stats));
+#endif
+
+#ifdef PPC_USE_MPI_PROFILER
+    const auto mpi_profiles = ppc::mpi_profiler::GatherProfiles();
+    perf.AddRecordSection("mpi_profile", ppc::mpi_profiler::ProfilesToJson(mpi_profiles));
+#endif
+
+    if (num_workers > 0) {
+      perf.AddRecordSection("weak_scaling", {{"size_per_worker", size_per_worker}, {"num_workers", num_workers}});
+    }
+
+    if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
+        task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL) {
+      perf.SetRankTimes(GatherToRootMPI(perf.GetPerfResults().time_sec));
+      if (perf_attr.collect_hw_counters) {
+        perf.AddRecordSection("hw_counters_per_rank", GatherHwCountersToRoot(perf));
+      }
+    }
+
     if (GetMPIRank() == 0) {
       perf.PrintPerfStatistic(test_name);
+#ifdef PPC_USE_ALLOC_TRACKER
+      std::cout << ppc::performance::alloc_tracker::FormatStats(
+          test_name + ":" + ppc::performance::GetStringParamName(mode), alloc_stats);
+#endif
+#ifdef PPC_USE_MPI_PROFILER
+      const auto profile_prefix = test_name + ":" + ppc::performance::GetStringParamName(mode);
+      std::cout << ppc::mpi_profiler::FormatProfiles(profile_prefix, mpi_profiles);
+#endif
     }
 
     OutType output_data = task_->GetOutput();
+    // The task's cached communicators and shared windows (which can hold a copy of the input) are only reused
+    // across the runs of one test, so they are released before the next test allocates its own
+    task_.reset();
+    ppc::mpi::ClearCommCache();
     ASSERT_TRUE(CheckTestOutputData(output_data));
   }
 
  private:
+  /// @brief Collects every rank's per-iteration hardware counters on rank 0 (null marks unavailable events).
+  static nlohmann::json GatherHwCountersToRoot(const ppc::performance::Perf<InType, OutType> &perf) {
+    auto per_rank = nlohmann::json::object();
+    for (std::size_t i = 0; i < ppc::performance::kNumHwCounters; i++) {
+      const auto counter = static_cast<ppc::performance::HwCounter>(i);
+      const auto local_value = perf.GetHwCounterPerIteration(counter);
+      const auto values = GatherToRootMPI(local_value.has_value() ? *local_value : -1.0);
+      auto values_json = nlohmann::json::array();
+      for (double value : values) {
+        values_json.push_back(value < 0.0 ? nlohmann::json(nullptr) : nlohmann::json(value));
+      }
+      per_rank[std::string(ppc::performance::GetHwCounterName(counter))] = values_json;
+    }
+    return per_rank;
+  }
+
   ppc::task::TaskPtr<InType, OutType> task_;
 };
 
@@ -111,10 +241,15 @@ auto MakePerfTaskTuples(const std::string &settings_path) {
   const auto name = std::string(GetNamespace<TaskType>()) + "_" +
                     ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
 
+  const auto type_of_task = TaskType::GetStaticTypeOfTask();
+  const auto residency = TaskType::GetStaticInputResidency();
+
   return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
-                                         ppc::performance::PerfResults::TypeOfRunning::kPipeline),
+                                         ppc::performance::PerfResults::TypeOfRunning::kPipeline, type_of_task,
+                                         residency),
                          std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
-                                         ppc::performance::PerfResults::TypeOfRunning::kTaskRun));
+                                         ppc::performance::PerfResults::TypeOfRunning::kTaskRun, type_of_task,
+                                         residency));
 }
 
 template <typename Tuple, std::size_t... I>
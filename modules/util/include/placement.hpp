@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief How ranks and their worker threads are bound to cores (PPC_BIND).
+enum class BindMode : uint8_t {
+  /// Leave placement to the OS
+  kNone,
+  /// Restrict every rank (and all threads it creates) to its own block of the node's cores
+  kRank,
+  /// Additionally pin each OpenMP/TBB worker and each BindCurrentThread() caller to one core of that block
+  kCore,
+};
+
+/// @brief Returns the mode name as accepted by PPC_BIND, e.g. "rank".
+std::string GetStringBindMode(BindMode mode);
+
+/// @brief Reads PPC_BIND (none, rank or core; default: none).
+/// @throws std::invalid_argument If the variable holds an unknown mode.
+BindMode GetBindMode();
+
+/// @brief Cores assigned to the calling rank.
+struct Placement {
+  BindMode mode = BindMode::kNone;
+  /// @brief Rank among the ranks sharing the node.
+  int local_rank = 0;
+  /// @brief Number of ranks sharing the node.
+  int local_size = 1;
+  /// @brief Logical CPU ids of the rank's block; empty when nothing is bound.
+  std::vector<int> cores;
+};
+
+/// @brief Returns the CPUs the process may run on (its affinity mask), or all hardware threads if unknown.
+std::vector<int> GetAvailableCores();
+
+/// @brief Splits the node's cores into contiguous blocks, one per node-local rank.
+/// @details The first cores.size() % local_size ranks get one extra core; with fewer cores than ranks,
+/// ranks share cores round-robin.
+std::vector<int> GetRankCoreSet(const std::vector<int> &node_cores, int local_rank, int local_size);
+
+/// @brief Picks the cores of a rank from the affinity masks every rank on the node started with.
+/// @details The rank's own mask is split between the ranks that share exactly that mask. Without launcher
+/// binding all ranks share the whole node and get a block each; with --bind-to socket or core every rank keeps
+/// the cores the launcher gave it, and ranks the launcher put on the same socket split that socket.
+/// @param node_masks Affinity mask of every node-local rank, indexed by node-local rank.
+std::vector<int> GetRankCoreSet(const std::vector<std::vector<int>> &node_masks, int local_rank);
+
+/// @brief Formats CPU ids compactly, e.g. "0-3,8,10-11".
+std::string FormatCoreList(const std::vector<int> &cores);
+
+/// @brief Returns the placement applied by the active ThreadPlacement (mode kNone if there is none).
+const Placement &GetPlacement();
+
+/// @brief Pins the calling thread to core thread_index of the rank's block when the mode is kCore.
+/// @details For std::thread workers; OpenMP and TBB workers are pinned automatically.
+/// @return True if the thread was pinned.
+bool BindCurrentThread(int thread_index);
+
+/// @brief Converts the placement to JSON for perf records.
+nlohmann::json PlacementToJson(const Placement &placement);
+
+/// @brief Applies a placement for its lifetime: binds the process and the OpenMP team, and pins TBB workers
+/// as they join the arena. Binding is best effort; on systems without affinity support (macOS) or when the
+/// mask cannot be changed the placement is still computed and reported.
+/// @details Collective over MPI_COMM_WORLD when MPI is initialized: determines node-local ranks and gathers their
+/// affinity masks, which are split as described at GetRankCoreSet(node_masks, local_rank).
+class ThreadPlacement {
+ public:
+  /// @param mode Binding mode; kNone only records the node layout.
+  /// @param num_threads Workers per rank, usually ppc::util::GetNumThreads().
+  ThreadPlacement(BindMode mode, int num_threads);
+  ThreadPlacement(const ThreadPlacement &) = delete;
+  ThreadPlacement &operator=(const ThreadPlacement &) = delete;
+  ~ThreadPlacement();
+
+  [[nodiscard]] const Placement &Get() const {
+    return placement_;
+  }
+
+ private:
+  class TbbPinningObserver;
+
+  Placement placement_;
+  std::unique_ptr<TbbPinningObserver> tbb_observer_;
+};
+
+}  // namespace ppc::util
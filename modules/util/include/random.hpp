@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief Philox4x32-10 counter-based generator (Salmon et al., SC'11), as used by Random123 and cuRAND.
+/// @details Bits(seed, stream, index) is a pure function: there is no state to advance, so any element
+/// of the sequence can be computed directly from its index.
+struct Philox4x32Engine {
+  static constexpr uint64_t Bits(uint64_t seed, uint64_t stream, uint64_t index) {
+    const auto block = Block({Lo(index), Hi(index), Lo(stream), Hi(stream)}, {Lo(seed), Hi(seed)});
+    return (static_cast<uint64_t>(block[1]) << 32U) | block[0];
+  }
+
+  /// @brief Full 128-bit output block for a counter and a key.
+  static constexpr std::array<uint32_t, 4> Block(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key) {
+    for (int round = 0; round < 10; round++) {
+      if (round > 0) {
+        key[0] += kWeyl0;
+        key[1] += kWeyl1;
+      }
+      const uint64_t p0 = static_cast<uint64_t>(kMul0) * counter[0];
+      const uint64_t p1 = static_cast<uint64_t>(kMul1) * counter[2];
+      counter = {Hi(p1) ^ counter[1] ^ key[0], Lo(p1), Hi(p0) ^ counter[3] ^ key[1], Lo(p0)};
+    }
+    return counter;
+  }
+
+ private:
+  static constexpr uint32_t kMul0 = 0xD2511F53U;
+  static constexpr uint32_t kMul1 = 0xCD9E8D57U;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9U;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85U;
+
+  static constexpr uint32_t Lo(uint64_t value) {
+    return static_cast<uint32_t>(value);
+  }
+
+  static constexpr uint32_t Hi(uint64_t value) {
+    return static_cast<uint32_t>(value >> 32U);
+  }
+};
+
+/// @brief SplitMix64 finalizer applied to a Weyl sequence: about three times cheaper than Philox,
+/// good enough for test data, but not crush-resistant across correlated seeds.
+struct SplitMix64Engine {
+  static constexpr uint64_t Bits(uint64_t seed, uint64_t stream, uint64_t index) {
+    const uint64_t key = Mix(seed ^ Mix(stream + kGamma));
+    return Mix(key + ((index + 1) * kGamma));
+  }
+
+  static constexpr uint64_t Mix(uint64_t z) {
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+  }
+
+ private:
+  static constexpr uint64_t kGamma = 0x9E3779B97F4A7C15ULL;
+};
+
+/// @brief High 64 bits of a 64x64-bit product without relying on __int128.
+constexpr uint64_t MulHi64(uint64_t a, uint64_t b) {
+  const uint64_t a_lo = a & 0xFFFFFFFFU;
+  const uint64_t a_hi = a >> 32U;
+  const uint64_t b_lo = b & 0xFFFFFFFFU;
+  const uint64_t b_hi = b >> 32U;
+  const uint64_t hi_lo = a_hi * b_lo;
+  const uint64_t cross = ((a_lo * b_lo) >> 32U) + (hi_lo & 0xFFFFFFFFU) + (a_lo * b_hi);
+  return (a_hi * b_hi) + (hi_lo >> 32U) + (cross >> 32U);
+}
+
+/// @brief Random number source addressed by element index instead of by call order.
+/// @details Value i depends only on (seed, stream, i), so a buffer filled by any number of threads or ranks,
+/// each generating its own index range, is bit-identical to a serial fill. Use different streams for
+/// independent sequences with the same seed (e.g. matrix A and matrix B).
+/// @tparam Engine Philox4x32Engine or SplitMix64Engine.
+template <typename Engine = Philox4x32Engine>
+class CounterRng {
+ public:
+  constexpr explicit CounterRng(uint64_t seed, uint64_t stream = 0) : seed_(seed), stream_(stream) {}
+
+  [[nodiscard]] constexpr uint64_t Bits(uint64_t index) const {
+    return Engine::Bits(seed_, stream_, index);
+  }
+
+  /// @brief Uniform double in [0, 1) with 53 random bits.
+  [[nodiscard]] constexpr double Uniform(uint64_t index) const {
+    return static_cast<double>(Bits(index) >> 11U) * 0x1.0p-53;
+  }
+
+  /// @brief Uniform value in [lo, hi).
+  template <std::floating_point T>
+  [[nodiscard]] constexpr T UniformReal(uint64_t index, T lo, T hi) const {
+    return static_cast<T>(lo + ((hi - lo) * Uniform(index)));
+  }
+
+  /// @brief Uniform integer in [lo, hi] (both inclusive).
+  /// @details Uses the multiply-shift reduction; the bias is below range / 2^64 and irrelevant for test data.
+  template <std::integral T>
+  [[nodiscard]] constexpr T UniformInt(uint64_t index, T lo, T hi) const {
+    const uint64_t range = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo) + 1;
+    const uint64_t offset = range == 0 ? Bits(index) : MulHi64(Bits(index), range);
+    return static_cast<T>(static_cast<uint64_t>(lo) + offset);
+  }
+
+ private:
+  uint64_t seed_;
+  uint64_t stream_;
+};
+
+/// @brief Sets out[i] = generator(first_index + i) using OpenMP threads.
+/// @details The generator must be a pure function of the index (e.g. a lambda over CounterRng), so the result
+/// does not depend on the number of threads. A rank filling its part of a global array passes the global index
+/// of its first element, e.g. GetBlockRange(n, rank, size).begin.
+/// @param num_threads Number of threads; 0 uses ppc::util::GetNumThreads().
+template <typename T, typename Generator>
+void ParallelFill(std::span<T> out, uint64_t first_index, Generator generator, int num_threads = 0) {
+  if (num_threads <= 0) {
+    num_threads = GetNumThreads();
+  }
+  const auto size = static_cast<int64_t>(out.size());
+#pragma omp parallel for schedule(static) num_threads(num_threads) if (size > 4096)
+  for (int64_t i = 0; i < size; i++) {
+    out[static_cast<std::size_t>(i)] = generator(first_index + static_cast<uint64_t>(i));
+  }
+}
+
+}  // namespace ppc::util
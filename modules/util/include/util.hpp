@@ -4,6 +4,7 @@
 #include <array>
 #include <atomic>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
@@ -68,17 +69,49 @@ enum class GTestParamIndex : uint8_t {
   kTaskGetter,
   kNameTest,
   kTestParams,
+  kTypeOfTask,
+  kInputResidency,
 };
 
 std::string GetAbsoluteTaskPath(const std::string &id_path, const std::string &relative_path);
 int GetNumThreads();
 int GetNumProc();
+int GetMPIRank();
+int GetMPISize();
 double GetTaskMaxTime();
 double GetPerfMaxTime();
+int GetPerfNumWarmup();
+double GetPerfTargetRelativeCI();
+bool GetPerfHwCounters();
+bool GetPerfWeakScaling();
+std::size_t GetPerfSizePerWorker();
+
+/// @brief Thread support levels of MPI_Init_thread, in increasing order.
+enum class MPIThreadLevel : uint8_t {
+  kSingle,
+  kFunneled,
+  kSerialized,
+  kMultiple,
+};
 
-template <typename T>
-std::string GetNamespace() {
-  std::string name = typeid(T).name();
+/// @brief Returns the level name as accepted by PPC_MPI_THREAD_LEVEL, e.g. "funneled".
+std::string GetStringMPIThreadLevel(MPIThreadLevel level);
+/// @brief Level the runners request from MPI_Init_thread (PPC_MPI_THREAD_LEVEL, default: funneled).
+/// @throws std::invalid_argument If the variable holds an unknown level.
+MPIThreadLevel GetMPIThreadLevelRequired();
+/// @brief Level provided by the MPI library (MPI_Query_thread); kSingle if MPI is not initialized.
+MPIThreadLevel GetMPIThreadLevel();
+/// @brief Converts the level to the matching MPI_THREAD_* constant.
+int ToMPIThreadLevel(MPIThreadLevel level);
+/// @brief Converts an MPI_THREAD_* constant to the level.
+MPIThreadLevel FromMPIThreadLevel(int mpi_level);
+
+std::string GetPerfOutputPath();
+std::string GetHostName();
+std::string GetGitRevision();
+
+/// @brief Extracts the namespace from a (possibly mangled) type name as returned by std::type_info::name().
+inline std::string GetNamespaceFromTypeName(std::string name) {
 #ifdef __GNUC__
   int status = 0;
   std::unique_ptr<char, void (*)(void *)> demangled{abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status),
@@ -99,6 +132,11 @@ std::string GetNamespace() {
   return (pos != std::string::npos) ? name.substr(0, pos) : std::string{};
 }
 
+template <typename T>
+std::string GetNamespace() {
+  return GetNamespaceFromTypeName(typeid(T).name());
+}
+
 inline std::shared_ptr<nlohmann::json> InitJSONPtr() {
   return std::make_shared<nlohmann::json>();
 }
@@ -0,0 +1,104 @@
+#include "util/include/data_cache.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <libenvpp/detail/get.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "util/include/dataset.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+namespace {
+
+constexpr auto kLockPollInterval = std::chrono::milliseconds(50);
+// A lock older than this belongs to a generator that died without cleaning up
+constexpr auto kStaleLockAge = std::chrono::minutes(30);
+
+bool IsStaleLock(const std::filesystem::path &lock_path) {
+  std::error_code ec;
+  const auto modified = std::filesystem::last_write_time(lock_path, ec);
+  return !ec && std::filesystem::file_time_type::clock::now() - modified > kStaleLockAge;
+}
+
+bool TryAcquireLock(const std::filesystem::path &lock_path) {
+  // "x" makes fopen fail if the file exists, so exactly one process creates the lock
+  std::FILE *lock = std::fopen(lock_path.string().c_str(), "wx");
+  if (lock == nullptr) {
+    return false;
+  }
+  std::fclose(lock);
+  return true;
+}
+
+std::string MakeTempSuffix() {
+  std::random_device device;
+  return ".tmp" + std::to_string(device());
+}
+
+}  // namespace
+
+std::string GetDataCacheDir() {
+  const auto dir = env::get<std::string>("PPC_DATA_CACHE_DIR");
+  if (dir.has_value() && !dir->empty()) {
+    return dir.value();
+  }
+  return (std::filesystem::temp_directory_path() / "ppc_data_cache").string();
+}
+
+std::string GetDataCachePath(const DataCacheKey &key, DType dtype) {
+  std::string name = key.generator;
+  for (std::size_t i = 0; i < key.shape.size(); i++) {
+    name += (i == 0 ? "_" : "x") + std::to_string(key.shape[i]);
+  }
+  name += "_t" + std::to_string(static_cast<uint32_t>(dtype)) + "_s" + std::to_string(key.seed) + ".ppcd";
+  const auto task_dir = test::SanitizeToken(key.task_id.empty() ? std::string("common") : key.task_id);
+  return (std::filesystem::path(GetDataCacheDir()) / task_dir / test::SanitizeToken(name)).string();
+}
+
+MappedDataset GetOrCreateCachedDataset(const DataCacheKey &key, DType dtype,
+                                       const std::function<void(const std::string &)> &write_dataset) {
+  namespace fs = std::filesystem;
+  const fs::path path = GetDataCachePath(key, dtype);
+  const fs::path lock_path = path.string() + ".lock";
+  std::error_code ec;
+  fs::create_directories(path.parent_path(), ec);
+
+  while (true) {
+    if (fs::exists(path, ec)) {
+      return MappedDataset(path.string());
+    }
+    if (TryAcquireLock(lock_path)) {
+      const fs::path tmp_path = path.string() + MakeTempSuffix();
+      try {
+        write_dataset(tmp_path.string());
+        fs::rename(tmp_path, path);
+      } catch (...) {
+        fs::remove(tmp_path, ec);
+        fs::remove(lock_path, ec);
+        throw;
+      }
+      fs::remove(lock_path, ec);
+      return MappedDataset(path.string());
+    }
+    if (!fs::exists(lock_path, ec) && !fs::exists(path, ec)) {
+      // The lock could not be created for a reason other than another generator
+      throw std::runtime_error("Failed to lock the data cache entry " + path.string());
+    }
+    if (IsStaleLock(lock_path)) {
+      fs::remove(lock_path, ec);
+      continue;
+    }
+    std::this_thread::sleep_for(kLockPollInterval);
+  }
+}
+
+}  // namespace ppc::util
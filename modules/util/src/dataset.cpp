@@ -0,0 +1,202 @@
+#include "util/include/dataset.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace ppc::util {
+
+namespace {
+
+constexpr std::array<char, 8> kDatasetMagic = {'P', 'P', 'C', 'D', 'S', 'E', 'T', '1'};
+constexpr std::size_t kHeaderSize = 128;
+
+struct DatasetHeader {
+  std::array<char, 8> magic{};
+  uint32_t dtype = 0;
+  uint32_t ndim = 0;
+  std::array<uint64_t, kDatasetMaxDims> dims{};
+};
+
+static_assert(sizeof(DatasetHeader) <= kHeaderSize);
+
+/// Number of elements of the shape (1 for a scalar), or std::nullopt if it does not fit into std::size_t
+std::optional<std::size_t> GetShapeProduct(const std::vector<std::size_t> &shape) {
+  std::size_t product = 1;
+  for (const std::size_t dim : shape) {
+    if (dim != 0 && product > std::numeric_limits<std::size_t>::max() / dim) {
+      return std::nullopt;
+    }
+    product *= dim;
+  }
+  return product;
+}
+
+DatasetHeader ParseHeader(std::span<const std::byte> bytes, const std::string &path) {
+  DatasetHeader header;
+  if (bytes.size() < kHeaderSize) {
+    throw std::runtime_error("Dataset file is too small: " + path);
+  }
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  if (header.magic != kDatasetMagic || header.ndim > kDatasetMaxDims ||
+      header.dtype > static_cast<uint32_t>(DType::kFloat64)) {
+    throw std::runtime_error("Not a dataset file: " + path);
+  }
+  return header;
+}
+
+}  // namespace
+
+std::size_t GetDTypeSize(DType dtype) {
+  switch (dtype) {
+    case DType::kInt8:
+    case DType::kUInt8:
+      return 1;
+    case DType::kInt32:
+    case DType::kUInt32:
+    case DType::kFloat32:
+      return 4;
+    case DType::kInt64:
+    case DType::kUInt64:
+    case DType::kFloat64:
+      return 8;
+  }
+  throw std::invalid_argument("Unknown dataset element type");
+}
+
+void WriteDataset(const std::string &path, DType dtype, const std::vector<std::size_t> &shape,
+                  std::span<const std::byte> payload) {
+  if (shape.size() > kDatasetMaxDims) {
+    throw std::runtime_error("Dataset has too many dimensions");
+  }
+  const auto elements = GetShapeProduct(shape);
+  if (!elements.has_value() || *elements != payload.size() / GetDTypeSize(dtype) ||
+      payload.size() % GetDTypeSize(dtype) != 0) {
+    throw std::runtime_error("Dataset shape does not match the payload size");
+  }
+  DatasetHeader header;
+  header.magic = kDatasetMagic;
+  header.dtype = static_cast<uint32_t>(dtype);
+  header.ndim = static_cast<uint32_t>(shape.size());
+  std::ranges::copy(shape, header.dims.begin());
+  std::array<char, kHeaderSize> header_bytes{};
+  std::memcpy(header_bytes.data(), &header, sizeof(header));
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  file.write(header_bytes.data(), static_cast<std::streamsize>(header_bytes.size()));
+  file.write(reinterpret_cast<const char *>(payload.data()), static_cast<std::streamsize>(payload.size()));
+  if (!file) {
+    throw std::runtime_error("Failed to write " + path);
+  }
+}
+
+MappedDataset::MappedDataset(const std::string &path) {
+  std::span<const std::byte> bytes;
+#ifdef _WIN32
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  fallback_buffer_.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(fallback_buffer_.data()), static_cast<std::streamsize>(fallback_buffer_.size()));
+  bytes = fallback_buffer_;
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  struct stat file_stat{};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    close(fd);
+    throw std::runtime_error("Dataset file is too small: " + path);
+  }
+  mapping_size_ = static_cast<std::size_t>(file_stat.st_size);
+  mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    throw std::runtime_error("Failed to map " + path);
+  }
+  bytes = {static_cast<const std::byte *>(mapping_), mapping_size_};
+#endif
+  try {
+    const auto header = ParseHeader(bytes, path);
+    dtype_ = static_cast<DType>(header.dtype);
+    shape_.assign(header.dims.begin(), header.dims.begin() + header.ndim);
+    // Compare element counts rather than byte sizes, so a corrupt shape cannot overflow past the check
+    const auto elements = GetShapeProduct(shape_);
+    if (!elements.has_value() || *elements > (bytes.size() - kHeaderSize) / GetDTypeSize(dtype_)) {
+      throw std::runtime_error("Dataset payload is truncated: " + path);
+    }
+  } catch (...) {
+    Release();
+    throw;
+  }
+  payload_ = bytes.data() + kHeaderSize;
+}
+
+MappedDataset::~MappedDataset() {
+  Release();
+}
+
+MappedDataset::MappedDataset(MappedDataset &&other) noexcept
+    : dtype_(other.dtype_),
+      shape_(std::move(other.shape_)),
+      payload_(std::exchange(other.payload_, nullptr)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      fallback_buffer_(std::move(other.fallback_buffer_)) {}
+
+MappedDataset &MappedDataset::operator=(MappedDataset &&other) noexcept {
+  if (this != &other) {
+    Release();
+    dtype_ = other.dtype_;
+    shape_ = std::move(other.shape_);
+    payload_ = std::exchange(other.payload_, nullptr);
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    fallback_buffer_ = std::move(other.fallback_buffer_);
+  }
+  return *this;
+}
+
+std::size_t MappedDataset::GetNumElements() const {
+  // The shape product was checked when the file was opened; a moved-from dataset has no payload
+  return payload_ == nullptr ? 0 : GetShapeProduct(shape_).value_or(0);
+}
+
+void MappedDataset::Release() {
+#ifndef _WIN32
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+#endif
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  payload_ = nullptr;
+  fallback_buffer_.clear();
+}
+
+}  // namespace ppc::util
@@ -1,5 +1,8 @@
 #include <mpi.h>
 
+#include <cstddef>
+#include <vector>
+
 #include "util/include/perf_test_util.hpp"
 
 double ppc::util::GetTimeMPI() {
@@ -11,3 +14,67 @@ int ppc::util::GetMPIRank() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   return rank;
 }
+
+int ppc::util::GetMPISize() {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+int ppc::util::ToMPIThreadLevel(MPIThreadLevel level) {
+  switch (level) {
+    case MPIThreadLevel::kSingle:
+      return MPI_THREAD_SINGLE;
+    case MPIThreadLevel::kFunneled:
+      return MPI_THREAD_FUNNELED;
+    case MPIThreadLevel::kSerialized:
+      return MPI_THREAD_SERIALIZED;
+    case MPIThreadLevel::kMultiple:
+      return MPI_THREAD_MULTIPLE;
+  }
+  return MPI_THREAD_SINGLE;
+}
+
+ppc::util::MPIThreadLevel ppc::util::FromMPIThreadLevel(int mpi_level) {
+  // The MPI standard only guarantees the order SINGLE < FUNNELED < SERIALIZED < MULTIPLE, not the values
+  if (mpi_level >= MPI_THREAD_MULTIPLE) {
+    return MPIThreadLevel::kMultiple;
+  }
+  if (mpi_level >= MPI_THREAD_SERIALIZED) {
+    return MPIThreadLevel::kSerialized;
+  }
+  if (mpi_level >= MPI_THREAD_FUNNELED) {
+    return MPIThreadLevel::kFunneled;
+  }
+  return MPIThreadLevel::kSingle;
+}
+
+ppc::util::MPIThreadLevel ppc::util::GetMPIThreadLevel() {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (initialized == 0 || finalized != 0) {
+    return MPIThreadLevel::kSingle;
+  }
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  return FromMPIThreadLevel(provided);
+}
+
+bool ppc::util::BroadcastDecisionMPI(bool local_decision) {
+  int decision = local_decision ? 1 : 0;
+  // Harness traffic goes through PMPI so the communication profiler does not attribute it to the task
+  PMPI_Bcast(&decision, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return decision != 0;
+}
+
+std::vector<double> ppc::util::GatherToRootMPI(double local_value) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  std::vector<double> values(rank == 0 ? static_cast<std::size_t>(size) : 0);
+  MPI_Gather(&local_value, 1, MPI_DOUBLE, values.data(), 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  return values;
+}
@@ -0,0 +1,274 @@
+#include "util/include/placement.hpp"
+
+#include <mpi.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <libenvpp/detail/get.hpp>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "oneapi/tbb/task_arena.h"
+#include "oneapi/tbb/task_scheduler_observer.h"
+#include "task/include/block_range.hpp"
+#include "util/include/util.hpp"
+
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+namespace ppc::util {
+
+namespace {
+
+Placement current_placement;
+
+/// Sets the affinity mask of the calling thread.
+#ifdef __linux__
+bool SetAffinity(const std::vector<int> &cores) {
+  if (cores.empty()) {
+    return false;
+  }
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int core : cores) {
+    CPU_SET(core, &mask);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+}
+#else
+bool SetAffinity(const std::vector<int> & /*cores*/) {
+  return false;
+}
+#endif
+
+bool PinToCore(const Placement &placement, int thread_index) {
+  if (placement.mode != BindMode::kCore || placement.cores.empty() || thread_index < 0) {
+    return false;
+  }
+  const auto core = placement.cores[static_cast<std::size_t>(thread_index) % placement.cores.size()];
+  return SetAffinity({core});
+}
+
+/// Affinity masks are exchanged as bitmaps of this many CPUs; cores beyond it are never assigned
+constexpr int kMaxMaskCpus = 1024;
+
+/// Determines the node-local rank and, if @p node_masks is given, gathers the affinity mask of every node-local
+/// rank into it.
+void GetNodeLayout(int &local_rank, int &local_size, std::vector<std::vector<int>> *node_masks) {
+  local_rank = 0;
+  local_size = 1;
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    if (node_masks != nullptr) {
+      *node_masks = {GetAvailableCores()};
+    }
+    return;
+  }
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+  MPI_Comm_rank(node_comm, &local_rank);
+  MPI_Comm_size(node_comm, &local_size);
+  if (node_masks != nullptr) {
+    std::vector<unsigned char> own_bits(kMaxMaskCpus, 0);
+    for (int core : GetAvailableCores()) {
+      if (core >= 0 && core < kMaxMaskCpus) {
+        own_bits[static_cast<std::size_t>(core)] = 1;
+      }
+    }
+    std::vector<unsigned char> all_bits(own_bits.size() * static_cast<std::size_t>(local_size));
+    MPI_Allgather(own_bits.data(), kMaxMaskCpus, MPI_UNSIGNED_CHAR, all_bits.data(), kMaxMaskCpus,
+                  MPI_UNSIGNED_CHAR, node_comm);
+    node_masks->assign(static_cast<std::size_t>(local_size), {});
+    for (std::size_t rank = 0; rank < node_masks->size(); rank++) {
+      for (int cpu = 0; cpu < kMaxMaskCpus; cpu++) {
+        if (all_bits[(rank * own_bits.size()) + static_cast<std::size_t>(cpu)] != 0) {
+          (*node_masks)[rank].push_back(cpu);
+        }
+      }
+    }
+  }
+  MPI_Comm_free(&node_comm);
+}
+
+}  // namespace
+
+std::string GetStringBindMode(BindMode mode) {
+  switch (mode) {
+    case BindMode::kNone:
+      return "none";
+    case BindMode::kRank:
+      return "rank";
+    case BindMode::kCore:
+      return "core";
+  }
+  return "unknown";
+}
+
+BindMode GetBindMode() {
+  const auto val = env::get<std::string>("PPC_BIND");
+  if (!val.has_value() || val->empty()) {
+    return BindMode::kNone;
+  }
+  std::string name = *val;
+  std::ranges::transform(name, name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  for (auto mode : {BindMode::kNone, BindMode::kRank, BindMode::kCore}) {
+    if (name == GetStringBindMode(mode)) {
+      return mode;
+    }
+  }
+  throw std::invalid_argument("Unknown PPC_BIND '" + *val + "', expected none, rank or core");
+}
+
+std::vector<int> GetAvailableCores() {
+  std::vector<int> cores;
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &mask)) {
+        cores.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (cores.empty()) {
+    const int count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int cpu = 0; cpu < count; cpu++) {
+      cores.push_back(cpu);
+    }
+  }
+  return cores;
+}
+
+std::vector<int> GetRankCoreSet(const std::vector<int> &node_cores, int local_rank, int local_size) {
+  if (local_size <= 0 || local_rank < 0 || local_rank >= local_size) {
+    throw std::invalid_argument("Node-local rank is out of range");
+  }
+  if (node_cores.empty()) {
+    return {};
+  }
+  const auto num_cores = node_cores.size();
+  const auto parts = static_cast<std::size_t>(local_size);
+  const auto part = static_cast<std::size_t>(local_rank);
+  if (num_cores < parts) {
+    return {node_cores[part % num_cores]};
+  }
+  const auto range = ppc::task::GetBlockRange(num_cores, part, parts);
+  return {node_cores.begin() + static_cast<std::ptrdiff_t>(range.begin),
+          node_cores.begin() + static_cast<std::ptrdiff_t>(range.end)};
+}
+
+std::vector<int> GetRankCoreSet(const std::vector<std::vector<int>> &node_masks, int local_rank) {
+  if (local_rank < 0 || std::cmp_greater_equal(local_rank, node_masks.size())) {
+    throw std::invalid_argument("Node-local rank is out of range");
+  }
+  const auto &own_mask = node_masks[static_cast<std::size_t>(local_rank)];
+  int group_rank = 0;
+  int group_size = 0;
+  for (std::size_t rank = 0; rank < node_masks.size(); rank++) {
+    if (node_masks[rank] == own_mask) {
+      if (std::cmp_less(rank, local_rank)) {
+        group_rank++;
+      }
+      group_size++;
+    }
+  }
+  return GetRankCoreSet(own_mask, group_rank, group_size);
+}
+
+std::string FormatCoreList(const std::vector<int> &cores) {
+  std::stringstream out;
+  for (std::size_t i = 0; i < cores.size();) {
+    std::size_t last = i;
+    while (last + 1 < cores.size() && cores[last + 1] == cores[last] + 1) {
+      last++;
+    }
+    out << (i == 0 ? "" : ",") << cores[i];
+    if (last > i) {
+      out << '-' << cores[last];
+    }
+    i = last + 1;
+  }
+  return out.str();
+}
+
+const Placement &GetPlacement() {
+  return current_placement;
+}
+
+bool BindCurrentThread(int thread_index) {
+  return PinToCore(current_placement, thread_index);
+}
+
+nlohmann::json PlacementToJson(const Placement &placement) {
+  return {{"bind", GetStringBindMode(placement.mode)},
+          {"local_rank", placement.local_rank},
+          {"local_size", placement.local_size},
+          {"cores", FormatCoreList(placement.cores)}};
+}
+
+/// Pins TBB worker threads to the rank's cores when they enter the arena.
+class ThreadPlacement::TbbPinningObserver : public tbb::task_scheduler_observer {
+ public:
+  TbbPinningObserver() {
+    observe(true);
+  }
+  TbbPinningObserver(const TbbPinningObserver &) = delete;
+  TbbPinningObserver &operator=(const TbbPinningObserver &) = delete;
+  ~TbbPinningObserver() override {
+    observe(false);
+  }
+
+  void on_scheduler_entry(bool is_worker) override {
+    if (is_worker) {
+      PinToCore(current_placement, tbb::this_task_arena::current_thread_index());
+    }
+  }
+};
+
+ThreadPlacement::ThreadPlacement(BindMode mode, int num_threads) {
+  placement_.mode = mode;
+  if (mode == BindMode::kNone) {
+    GetNodeLayout(placement_.local_rank, placement_.local_size, nullptr);
+    current_placement = placement_;
+    return;
+  }
+  // The launcher may already have bound every rank (e.g. --bind-to socket), so split the masks the ranks
+  // actually have instead of splitting this rank's mask once more by node-local rank
+  std::vector<std::vector<int>> node_masks;
+  GetNodeLayout(placement_.local_rank, placement_.local_size, &node_masks);
+  placement_.cores = GetRankCoreSet(node_masks, placement_.local_rank);
+  current_placement = placement_;
+
+  // Threads inherit the mask of their creator, so every worker started later stays inside the rank's block
+  SetAffinity(placement_.cores);
+  if (mode != BindMode::kCore) {
+    return;
+  }
+  // The master keeps the whole block (threads it creates later inherit its mask); workers get one core each
+#pragma omp parallel num_threads(std::max(num_threads, 1))
+  {
+    if (const int thread = omp_get_thread_num(); thread > 0) {
+      PinToCore(placement_, thread);
+    }
+  }
+  tbb_observer_ = std::make_unique<TbbPinningObserver>();
+}
+
+ThreadPlacement::~ThreadPlacement() {
+  tbb_observer_.reset();
+  current_placement = {};
+}
+
+}  // namespace ppc::util
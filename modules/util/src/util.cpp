@@ -2,10 +2,21 @@
 
 #include <algorithm>
 #include <array>
+#include <cctype>
+#include <cstddef>
 #include <filesystem>
 #include <libenvpp/detail/get.hpp>
+#include <stdexcept>
 #include <string>
 
+#ifdef _WIN32
+#  include <cstdlib>
+#else
+#  include <unistd.h>
+#endif
+
+#include "ppc_git_revision.hpp"
+
 namespace {
 
 std::string GetAbsolutePath(const std::string &relative_path) {
@@ -52,6 +63,100 @@ double ppc::util::GetPerfMaxTime() {
   return 10.0;
 }
 
+int ppc::util::GetPerfNumWarmup() {
+  const auto val = env::get<int>("PPC_PERF_NUM_WARMUP");
+  if (val.has_value() && val.value() > 0) {
+    return val.value();
+  }
+  return 0;
+}
+
+double ppc::util::GetPerfTargetRelativeCI() {
+  const auto val = env::get<double>("PPC_PERF_TARGET_RCI");
+  if (val.has_value() && val.value() > 0.0) {
+    return val.value();
+  }
+  return 0.0;
+}
+
+bool ppc::util::GetPerfHwCounters() {
+  const auto val = env::get<int>("PPC_PERF_HW_COUNTERS");
+  return val.has_value() && val.value() != 0;
+}
+
+bool ppc::util::GetPerfWeakScaling() {
+  const auto val = env::get<int>("PPC_PERF_WEAK_SCALING");
+  return val.has_value() && val.value() != 0;
+}
+
+std::size_t ppc::util::GetPerfSizePerWorker() {
+  const auto val = env::get<std::size_t>("PPC_PERF_SIZE_PER_WORKER");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 0;
+}
+
+std::string ppc::util::GetStringMPIThreadLevel(MPIThreadLevel level) {
+  switch (level) {
+    case MPIThreadLevel::kSingle:
+      return "single";
+    case MPIThreadLevel::kFunneled:
+      return "funneled";
+    case MPIThreadLevel::kSerialized:
+      return "serialized";
+    case MPIThreadLevel::kMultiple:
+      return "multiple";
+  }
+  return "unknown";
+}
+
+ppc::util::MPIThreadLevel ppc::util::GetMPIThreadLevelRequired() {
+  const auto val = env::get<std::string>("PPC_MPI_THREAD_LEVEL");
+  if (!val.has_value() || val->empty()) {
+    return MPIThreadLevel::kFunneled;
+  }
+  std::string name = *val;
+  std::ranges::transform(name, name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  for (auto level : {MPIThreadLevel::kSingle, MPIThreadLevel::kFunneled, MPIThreadLevel::kSerialized,
+                     MPIThreadLevel::kMultiple}) {
+    if (name == GetStringMPIThreadLevel(level)) {
+      return level;
+    }
+  }
+  throw std::invalid_argument("Unknown PPC_MPI_THREAD_LEVEL '" + *val +
+                              "', expected single, funneled, serialized or multiple");
+}
+
+std::string ppc::util::GetPerfOutputPath() {
+  const auto val = env::get<std::string>("PPC_PERF_OUTPUT");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return {};
+}
+
+std::string ppc::util::GetHostName() {
+#ifdef _WIN32
+  const char *name = std::getenv("COMPUTERNAME");
+  return (name != nullptr) ? std::string(name) : std::string("unknown");
+#else
+  std::array<char, 256> name{};
+  if (gethostname(name.data(), name.size() - 1) != 0) {
+    return "unknown";
+  }
+  return {name.data()};
+#endif
+}
+
+std::string ppc::util::GetGitRevision() {
+  const auto val = env::get<std::string>("PPC_GIT_REVISION");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return PPC_GIT_REVISION;
+}
+
 // List of environment variables that signal the application is running under
 // an MPI launcher. The array size must match the number of entries to avoid
 // looking up empty environment variable names.
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <libenvpp/detail/environment.hpp>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/include/data_cache.hpp"
+#include "util/include/dataset.hpp"
+
+namespace {
+
+class DataCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    cache_dir_ = std::filesystem::temp_directory_path() / "ppc_data_cache_test";
+    std::filesystem::remove_all(cache_dir_);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(cache_dir_);
+  }
+
+  std::filesystem::path cache_dir_;
+};
+
+void FillIota(std::span<int32_t> data) {
+  for (std::size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<int32_t>(i * 3);
+  }
+}
+
+}  // namespace
+
+TEST_F(DataCacheTest, GeneratesOnceAndReusesTheFile) {
+  env::detail::set_scoped_environment_variable scoped("PPC_DATA_CACHE_DIR", cache_dir_.string());
+  const ppc::util::DataCacheKey key{.task_id = "my_task", .generator = "iota_v1", .shape = {4, 5}, .seed = 7};
+  int calls = 0;
+  const std::function<void(std::span<int32_t>)> generate = [&calls](std::span<int32_t> data) {
+    calls++;
+    FillIota(data);
+  };
+
+  const auto first = ppc::util::GetOrCreateCachedDataset<int32_t>(key, generate);
+  const auto second = ppc::util::GetOrCreateCachedDataset<int32_t>(key, generate);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(second.GetShape(), (std::vector<std::size_t>{4, 5}));
+  EXPECT_EQ(second.View<int32_t>()[19], 57);
+  EXPECT_TRUE(std::filesystem::exists(ppc::util::GetDataCachePath(key, ppc::util::DType::kInt32)));
+
+  auto other_seed = key;
+  other_seed.seed = 8;
+  (void)ppc::util::GetOrCreateCachedDataset<int32_t>(other_seed, generate);
+  EXPECT_EQ(calls, 2);
+}
+
+TEST_F(DataCacheTest, ConcurrentProcessesShareOneGeneration) {
+  env::detail::set_scoped_environment_variable scoped("PPC_DATA_CACHE_DIR", cache_dir_.string());
+  const ppc::util::DataCacheKey key{.task_id = "my_task", .generator = "iota_v1", .shape = {1000}, .seed = 1};
+  std::atomic<int> calls{0};
+  const std::function<void(std::span<int32_t>)> generate = [&calls](std::span<int32_t> data) {
+    calls++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    FillIota(data);
+  };
+
+  std::vector<std::thread> workers;
+  std::atomic<int> matches{0};
+  for (int i = 0; i < 4; i++) {
+    workers.emplace_back([&] {
+      const auto dataset = ppc::util::GetOrCreateCachedDataset<int32_t>(key, generate);
+      if (dataset.View<int32_t>()[999] == 2997) {
+        matches++;
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  EXPECT_EQ(calls.load(), 1);
+  EXPECT_EQ(matches.load(), 4);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/include/dataset.hpp"
+
+namespace {
+
+std::string TempDatasetPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace
+
+TEST(DatasetTest, WrittenDatasetIsMappedWithShapeAndType) {
+  const auto path = TempDatasetPath("ppc_dataset_matrix.ppcd");
+  std::vector<double> matrix(6);
+  std::iota(matrix.begin(), matrix.end(), 1.0);
+  ppc::util::WriteDataset<double>(path, matrix, {2, 3});
+
+  ppc::util::MappedDataset dataset(path);
+  EXPECT_EQ(dataset.GetDType(), ppc::util::DType::kFloat64);
+  EXPECT_EQ(dataset.GetShape(), (std::vector<std::size_t>{2, 3}));
+  ASSERT_EQ(dataset.GetNumElements(), 6U);
+  const auto view = dataset.View<double>();
+  EXPECT_EQ(std::vector<double>(view.begin(), view.end()), matrix);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view.data()) % alignof(double), 0U);
+  EXPECT_THROW((void)dataset.View<int32_t>(), std::runtime_error);
+
+  ppc::util::MappedDataset moved(std::move(dataset));
+  EXPECT_EQ(moved.View<double>()[5], 6.0);
+  std::filesystem::remove(path);
+}
+
+TEST(DatasetTest, ScalarDatasetRoundTrips) {
+  const auto path = TempDatasetPath("ppc_dataset_scalar.ppcd");
+  const std::vector<int64_t> value = {42};
+  const std::vector<int64_t> two = {1, 2};
+  EXPECT_THROW(ppc::util::WriteDataset(path, ppc::util::DType::kInt64, {}, std::as_bytes(std::span(two))),
+               std::runtime_error);
+
+  ppc::util::WriteDataset(path, ppc::util::DType::kInt64, {}, std::as_bytes(std::span(value)));
+  ppc::util::MappedDataset dataset(path);
+  EXPECT_TRUE(dataset.GetShape().empty());
+  ASSERT_EQ(dataset.GetNumElements(), 1U);
+  EXPECT_EQ(dataset.View<int64_t>()[0], 42);
+  std::filesystem::remove(path);
+}
+
+TEST(DatasetTest, RejectsShapeThatOverflowsTheSizeCheck) {
+  const auto path = TempDatasetPath("ppc_dataset_overflow.ppcd");
+  const std::vector<double> values = {1.0, 2.0};
+  ppc::util::WriteDataset<double>(path, values);
+  {
+    // dims[0] sits right after magic, dtype and ndim; 2^61 doubles wrap the byte count around to 0
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    const uint64_t huge = uint64_t{1} << 61;
+    file.seekp(16);
+    file.write(reinterpret_cast<const char *>(&huge), sizeof(huge));
+  }
+  EXPECT_THROW(ppc::util::MappedDataset{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(DatasetTest, RejectsMismatchedShapeAndForeignFiles) {
+  const auto path = TempDatasetPath("ppc_dataset_invalid.ppcd");
+  const std::vector<int32_t> values = {1, 2, 3};
+  EXPECT_THROW(ppc::util::WriteDataset<int32_t>(path, values, {2, 2}), std::runtime_error);
+
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << std::string(200, 'x');
+  }
+  EXPECT_THROW(ppc::util::MappedDataset{path}, std::runtime_error);
+  std::filesystem::remove(path);
+  EXPECT_THROW(ppc::util::MappedDataset{path}, std::runtime_error);
+}
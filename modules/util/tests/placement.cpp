@@ -0,0 +1,70 @@
+#include "util/include/placement.hpp"
+
+#include <gtest/gtest.h>
+
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+#include <vector>
+
+using ppc::util::BindMode;
+
+TEST(PlacementTest, SplitsNodeCoresIntoRankBlocks) {
+  const std::vector<int> cores = {0, 1, 2, 3, 8, 9, 10};
+  EXPECT_EQ(ppc::util::GetRankCoreSet(cores, 0, 3), (std::vector<int>{0, 1, 2}));
+  EXPECT_EQ(ppc::util::GetRankCoreSet(cores, 1, 3), (std::vector<int>{3, 8}));
+  EXPECT_EQ(ppc::util::GetRankCoreSet(cores, 2, 3), (std::vector<int>{9, 10}));
+  // More ranks than cores: ranks share cores round-robin
+  EXPECT_EQ(ppc::util::GetRankCoreSet({4, 5}, 3, 4), (std::vector<int>{5}));
+  EXPECT_THROW(ppc::util::GetRankCoreSet(cores, 3, 3), std::invalid_argument);
+}
+
+TEST(PlacementTest, SplitsLauncherMasksOnlyBetweenRanksSharingThem) {
+  const std::vector<int> node = {0, 1, 2, 3, 4, 5, 6, 7};
+  // No launcher binding: every rank sees the whole node and gets a block of it
+  EXPECT_EQ(ppc::util::GetRankCoreSet({node, node}, 1), (std::vector<int>{4, 5, 6, 7}));
+
+  // --bind-to socket with one rank per socket: each rank keeps its socket
+  const std::vector<int> socket0 = {0, 1, 2, 3};
+  const std::vector<int> socket1 = {4, 5, 6, 7};
+  EXPECT_EQ(ppc::util::GetRankCoreSet({socket0, socket1}, 0), socket0);
+  EXPECT_EQ(ppc::util::GetRankCoreSet({socket0, socket1}, 1), socket1);
+
+  // Ranks mapped round-robin over sockets split the socket they share
+  const std::vector<std::vector<int>> round_robin = {socket0, socket1, socket0, socket1};
+  EXPECT_EQ(ppc::util::GetRankCoreSet(round_robin, 2), (std::vector<int>{2, 3}));
+  EXPECT_EQ(ppc::util::GetRankCoreSet(round_robin, 1), (std::vector<int>{4, 5}));
+  EXPECT_THROW(ppc::util::GetRankCoreSet(round_robin, 4), std::invalid_argument);
+}
+
+TEST(PlacementTest, FormatsCoreListsAsRanges) {
+  EXPECT_EQ(ppc::util::FormatCoreList({0, 1, 2, 3, 8, 10, 11}), "0-3,8,10-11");
+  EXPECT_EQ(ppc::util::FormatCoreList({5}), "5");
+  EXPECT_EQ(ppc::util::FormatCoreList({}), "");
+}
+
+TEST(PlacementTest, ReadsBindModeFromEnvironment) {
+  EXPECT_EQ(ppc::util::GetBindMode(), BindMode::kNone);
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_BIND", "Core");
+    EXPECT_EQ(ppc::util::GetBindMode(), BindMode::kCore);
+  }
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_BIND", "socket");
+    EXPECT_THROW(ppc::util::GetBindMode(), std::invalid_argument);
+  }
+}
+
+TEST(PlacementTest, RankPlacementIsReportedWhileActive) {
+  const auto available = ppc::util::GetAvailableCores();
+  ASSERT_FALSE(available.empty());
+  {
+    // Without MPI the process is the only rank on the node, so its mask does not change
+    const ppc::util::ThreadPlacement placement(BindMode::kRank, 2);
+    EXPECT_EQ(ppc::util::GetPlacement().mode, BindMode::kRank);
+    EXPECT_EQ(ppc::util::GetPlacement().cores, available);
+    EXPECT_EQ(ppc::util::PlacementToJson(placement.Get())["local_size"], 1);
+    // Only kCore pins single threads
+    EXPECT_FALSE(ppc::util::BindCurrentThread(0));
+  }
+  EXPECT_EQ(ppc::util::GetPlacement().mode, BindMode::kNone);
+}
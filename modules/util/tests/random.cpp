@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "util/include/random.hpp"
+
+using ppc::util::CounterRng;
+using ppc::util::ParallelFill;
+using ppc::util::Philox4x32Engine;
+using ppc::util::SplitMix64Engine;
+
+TEST(CounterRngTest, PhiloxMatchesReferenceVectors) {
+  // Known-answer vectors of the Random123 reference implementation
+  EXPECT_EQ(Philox4x32Engine::Block({0, 0, 0, 0}, {0, 0}),
+            (std::array<uint32_t, 4>{0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U}));
+  EXPECT_EQ(Philox4x32Engine::Block({0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU}, {0xffffffffU, 0xffffffffU}),
+            (std::array<uint32_t, 4>{0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU}));
+}
+
+TEST(CounterRngTest, ValuesDependOnSeedStreamAndIndexOnly) {
+  const CounterRng<> rng(42);
+  EXPECT_EQ(rng.Bits(7), CounterRng<>(42).Bits(7));
+  EXPECT_NE(rng.Bits(7), rng.Bits(8));
+  EXPECT_NE(rng.Bits(7), CounterRng<>(43).Bits(7));
+  EXPECT_NE(rng.Bits(7), CounterRng<>(42, 1).Bits(7));
+  EXPECT_NE(CounterRng<SplitMix64Engine>(42).Bits(7), CounterRng<SplitMix64Engine>(42, 1).Bits(7));
+}
+
+TEST(CounterRngTest, DistributionsStayInBounds) {
+  const CounterRng<SplitMix64Engine> rng(1);
+  std::array<int, 7> hits{};
+  for (uint64_t i = 0; i < 10000; i++) {
+    const int value = rng.UniformInt(i, -3, 3);
+    ASSERT_GE(value, -3);
+    ASSERT_LE(value, 3);
+    hits[static_cast<std::size_t>(value + 3)]++;
+    const double real = rng.UniformReal(i, -1.0e6, 1.0e6);
+    ASSERT_GE(real, -1.0e6);
+    ASSERT_LT(real, 1.0e6);
+  }
+  for (int count : hits) {
+    EXPECT_GT(count, 1200);
+  }
+  EXPECT_EQ(rng.UniformInt<uint64_t>(5, 0, UINT64_MAX), rng.Bits(5));
+}
+
+TEST(CounterRngTest, ParallelFillIsIndependentOfThreadsAndRanks) {
+  const CounterRng<> rng(2024);
+  auto generator = [&rng](uint64_t i) { return rng.UniformInt<int32_t>(i, -1000, 1000); };
+  constexpr std::size_t kSize = 100003;
+
+  std::vector<int32_t> serial(kSize);
+  for (std::size_t i = 0; i < kSize; i++) {
+    serial[i] = generator(i);
+  }
+  std::vector<int32_t> threaded(kSize);
+  ParallelFill(std::span<int32_t>(threaded), 0, generator, 4);
+  EXPECT_EQ(threaded, serial);
+
+  // Three "ranks" filling their own blocks reproduce the global sequence
+  std::vector<int32_t> by_ranks(kSize);
+  const std::array<std::size_t, 4> bounds{0, 33335, 66670, kSize};
+  for (std::size_t rank = 0; rank < 3; rank++) {
+    const std::span<int32_t> block(by_ranks.data() + bounds[rank], bounds[rank + 1] - bounds[rank]);
+    ParallelFill(block, bounds[rank], generator, static_cast<int>(rank) + 1);
+  }
+  EXPECT_EQ(by_ranks, serial);
+}
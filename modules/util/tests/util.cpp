@@ -4,9 +4,11 @@
 
 #include <libenvpp/detail/environment.hpp>
 #include <libenvpp/detail/get.hpp>
+#include <stdexcept>
 #include <string>
 
 #include "omp.h"
+#include "util/include/comm_thread.hpp"
 
 namespace my::nested {
 struct Type {};
@@ -124,3 +126,57 @@ TEST(GetNumProc, ReadsFromEnvironment) {
   env::detail::set_scoped_environment_variable scoped("PPC_NUM_PROC", "4");
   EXPECT_EQ(ppc::util::GetNumProc(), 4);
 }
+
+TEST(GetPerfNumWarmup, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<int>("PPC_PERF_NUM_WARMUP");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_NUM_WARMUP");
+  }
+  EXPECT_EQ(ppc::util::GetPerfNumWarmup(), 0);
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_NUM_WARMUP", std::to_string(*old));
+  }
+}
+
+TEST(GetPerfNumWarmup, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_NUM_WARMUP", "3");
+  EXPECT_EQ(ppc::util::GetPerfNumWarmup(), 3);
+}
+
+TEST(GetPerfWeakScaling, ReadsFromEnvironment) {
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_WEAK_SCALING", "1");
+    EXPECT_TRUE(ppc::util::GetPerfWeakScaling());
+  }
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_WEAK_SCALING", "0");
+    EXPECT_FALSE(ppc::util::GetPerfWeakScaling());
+  }
+}
+
+TEST(GetPerfSizePerWorker, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_SIZE_PER_WORKER", "4096");
+  EXPECT_EQ(ppc::util::GetPerfSizePerWorker(), 4096U);
+}
+
+TEST(GetMPIThreadLevelRequired, DefaultsToFunneledAndReadsFromEnvironment) {
+  EXPECT_EQ(ppc::util::GetMPIThreadLevelRequired(), ppc::util::MPIThreadLevel::kFunneled);
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_MPI_THREAD_LEVEL", "Multiple");
+    EXPECT_EQ(ppc::util::GetMPIThreadLevelRequired(), ppc::util::MPIThreadLevel::kMultiple);
+  }
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_MPI_THREAD_LEVEL", "threads");
+    EXPECT_THROW(ppc::util::GetMPIThreadLevelRequired(), std::invalid_argument);
+  }
+}
+
+TEST(GetMPIThreadLevel, ConvertsToAndFromMPIConstants) {
+  for (auto level : {ppc::util::MPIThreadLevel::kSingle, ppc::util::MPIThreadLevel::kFunneled,
+                     ppc::util::MPIThreadLevel::kSerialized, ppc::util::MPIThreadLevel::kMultiple}) {
+    EXPECT_EQ(ppc::util::FromMPIThreadLevel(ppc::util::ToMPIThreadLevel(level)), level);
+  }
+  // The core tests run without MPI, where no helper thread may communicate
+  EXPECT_EQ(ppc::util::GetMPIThreadLevel(), ppc::util::MPIThreadLevel::kSingle);
+  EXPECT_THROW(ppc::util::CommThread([] {}), std::runtime_error);
+}
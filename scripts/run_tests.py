@@ -14,8 +14,12 @@ def init_cmd_args():
     parser.add_argument(
         "--running-type",
         required=True,
-        choices=["threads", "processes", "performance"],
-        help="Specify the execution mode. Choose 'threads' for multithreading or 'processes' for multiprocessing.",
+        choices=["threads", "processes", "performance", "scaling"],
+        help=(
+            "Specify the execution mode. Choose 'threads' for multithreading or 'processes' for multiprocessing. "
+            "'scaling' runs the perf tests matching --gtest-filter once per value of --counts and builds "
+            "speedup/efficiency tables."
+        ),
     )
     parser.add_argument(
         "--additional-mpi-args",
@@ -29,6 +33,34 @@ def init_cmd_args():
         type=int,
         help="List of process/thread counts to run sequentially",
     )
+    parser.add_argument(
+        "--gtest-filter",
+        default="*",
+        help="GoogleTest filter selecting the perf tests of a scaling sweep (default: '*').",
+    )
+    parser.add_argument(
+        "--scaling-mode",
+        choices=["processes", "threads"],
+        default="processes",
+        help="Whether --counts are PPC_NUM_PROC or PPC_NUM_THREADS values in a scaling sweep.",
+    )
+    parser.add_argument(
+        "--scaling-kind",
+        choices=["strong", "weak"],
+        default="strong",
+        help="Interpret a scaling sweep as strong (fixed input) or weak (input per worker) scaling.",
+    )
+    parser.add_argument(
+        "--size-per-worker",
+        type=int,
+        default=None,
+        help="Work per worker for a weak scaling sweep (default: each task's own value).",
+    )
+    parser.add_argument(
+        "--output-dir",
+        default="scaling_results",
+        help="Directory for perf records and scaling tables of a sweep (default: 'scaling_results').",
+    )
     parser.add_argument(
         "--build-dir",
         default="build",
@@ -243,6 +275,19 @@ class PPCRunner:
             )
         mpi_running = self.__build_mpi_cmd(ppc_num_proc, additional_mpi_args)
         if not self.__ppc_env.get("PPC_ASAN_RUN"):
+            self.__run_exec(
+                mpi_running
+                + [str(self.work_dir / "core_func_tests")]
+                + self.__get_gtest_settings(1, "MpiRun")
+            )
+            # Only built with -D USE_MPI_PROFILER=ON
+            profiler_tests = self.work_dir / "ppc_mpi_profiler_tests"
+            if profiler_tests.exists():
+                self.__run_exec(
+                    mpi_running
+                    + [str(profiler_tests)]
+                    + self.__get_gtest_settings(1, "Profiler")
+                )
             for task_type in ["all", "mpi"]:
                 self.__run_exec(
                     mpi_running
@@ -266,6 +311,63 @@ class PPCRunner:
                 + self.__get_gtest_settings(1, "_" + task_type + "_")
             )
 
+    def run_scaling_point(self, scaling_mode, gtest_filter, additional_mpi_args=""):
+        """Run the selected perf tests once with the current PPC_NUM_PROC/PPC_NUM_THREADS."""
+        command = [
+            str(self.work_dir / "ppc_perf_tests"),
+            "--gtest_color=0",
+            f"--gtest_filter={gtest_filter}",
+        ]
+        if scaling_mode == "processes":
+            command = (
+                self.__build_mpi_cmd(self.__ppc_num_proc, additional_mpi_args) + command
+            )
+        self.__run_exec(command)
+
+
+def _run_scaling_sweep(args_dict):
+    from scaling_table import build_scaling_tables
+
+    counts = args_dict.get("counts")
+    if not counts:
+        raise EnvironmentError("Scaling sweep requires --counts.")
+
+    scaling_mode = args_dict["scaling_mode"]
+    output_dir = Path(args_dict["output_dir"]).resolve()
+    output_dir.mkdir(parents=True, exist_ok=True)
+    records = []
+    for count in counts:
+        env_copy = os.environ.copy()
+        if scaling_mode == "processes":
+            env_copy["PPC_NUM_PROC"] = str(count)
+            env_copy.setdefault("PPC_NUM_THREADS", "1")
+        else:
+            env_copy["PPC_NUM_THREADS"] = str(count)
+            env_copy.setdefault("PPC_NUM_PROC", "1")
+        record_path = output_dir / f"{scaling_mode}_{count}.jsonl"
+        record_path.unlink(missing_ok=True)
+        env_copy["PPC_PERF_OUTPUT"] = str(record_path)
+        if args_dict["scaling_kind"] == "weak":
+            env_copy["PPC_PERF_WEAK_SCALING"] = "1"
+            if args_dict.get("size_per_worker"):
+                env_copy["PPC_PERF_SIZE_PER_WORKER"] = str(args_dict["size_per_worker"])
+
+        print(f"Executing scaling sweep with {scaling_mode} count: {count}", flush=True)
+        runner = PPCRunner(
+            build_dir=args_dict.get("build_dir", "build"),
+            verbose=args_dict.get("verbose", False),
+        )
+        runner.setup_env(env_copy)
+        runner.run_scaling_point(
+            scaling_mode, args_dict["gtest_filter"], args_dict["additional_mpi_args"]
+        )
+        records.append(str(record_path))
+
+    csv_path = build_scaling_tables(
+        records, str(output_dir), scaling_mode, args_dict["scaling_kind"]
+    )
+    print(f"Scaling table written to {csv_path}", flush=True)
+
 
 def _execute(args_dict, env):
     runner = PPCRunner(
@@ -291,7 +393,9 @@ if __name__ == "__main__":
     args_dict = init_cmd_args()
     counts = args_dict.get("counts")
 
-    if counts:
+    if args_dict["running_type"] == "scaling":
+        _run_scaling_sweep(args_dict)
+    elif counts:
         for count in counts:
             env_copy = os.environ.copy()
 
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Build strong/weak scaling tables from structured perf records.
+
+Records are the JSON Lines written by the perf runner when ``PPC_PERF_OUTPUT``
+is set (one object per test). Every record carries ``num_proc`` and
+``num_threads``, so records from several runs with different worker counts
+can be combined into one table per task, technology and run type.
+"""
+
+import argparse
+import csv
+import json
+import os
+
+SCALING_KINDS = ("strong", "weak")
+WORKER_KEYS = {"processes": "num_proc", "threads": "num_threads"}
+
+CSV_HEADER = [
+    "task",
+    "technology",
+    "type_of_running",
+    "workers",
+    "time_sec",
+    "speedup",
+    "efficiency",
+    "karp_flatt",
+]
+
+
+def load_records(paths):
+    """Read perf records from JSON Lines files, skipping blank lines."""
+    records = []
+    for path in paths:
+        with open(path, "r") as records_file:
+            for line in records_file:
+                line = line.strip()
+                if line:
+                    records.append(json.loads(line))
+    return records
+
+
+def _record_time(record):
+    # The median is less sensitive to noisy iterations than the mean
+    statistics = record.get("statistics") or {}
+    median = statistics.get("median_sec")
+    if median is not None and median > 0.0:
+        return median
+    return record["time_sec"]
+
+
+def karp_flatt(speedup, workers):
+    """Experimentally determined serial fraction; undefined for a single worker."""
+    if workers <= 1 or speedup <= 0.0:
+        return None
+    return (1.0 / speedup - 1.0 / workers) / (1.0 - 1.0 / workers)
+
+
+def compute_scaling(records, worker_key="num_proc", kind="strong"):
+    """Compute speedup, efficiency and Karp-Flatt serial fraction per task.
+
+    The baseline of every (task, technology, type_of_running) group is its
+    record with the fewest workers ``p0``. With ``p`` workers and relative
+    worker count ``r = p / p0``:
+
+    - strong scaling: ``S = T(p0) / T(p)``, ``E = S / r``;
+    - weak scaling (input grows with workers): ``E = T(p0) / T(p)``,
+      ``S = r * E`` (scaled speedup).
+
+    Later records for the same worker count replace earlier ones.
+    """
+    if kind not in SCALING_KINDS:
+        raise ValueError(f"Unknown scaling kind '{kind}'")
+
+    groups = {}
+    for record in records:
+        key = (record["task"], record["technology"], record["type_of_running"])
+        groups.setdefault(key, {})[int(record[worker_key])] = _record_time(record)
+
+    rows = []
+    for (task, technology, type_of_running), times in sorted(groups.items()):
+        base_workers = min(times)
+        base_time = times[base_workers]
+        for workers in sorted(times):
+            time_sec = times[workers]
+            relative_workers = workers / base_workers
+            if time_sec <= 0.0:
+                speedup = efficiency = None
+            elif kind == "strong":
+                speedup = base_time / time_sec
+                efficiency = speedup / relative_workers
+            else:
+                efficiency = base_time / time_sec
+                speedup = relative_workers * efficiency
+            rows.append(
+                {
+                    "task": task,
+                    "technology": technology,
+                    "type_of_running": type_of_running,
+                    "workers": workers,
+                    "time_sec": time_sec,
+                    "speedup": speedup,
+                    "efficiency": efficiency,
+                    "karp_flatt": (
+                        karp_flatt(speedup, relative_workers)
+                        if speedup is not None
+                        else None
+                    ),
+                }
+            )
+    return rows
+
+
+def write_csv(path, rows):
+    with open(path, "w", newline="") as csv_file:
+        writer = csv.DictWriter(csv_file, fieldnames=CSV_HEADER)
+        writer.writeheader()
+        for row in rows:
+            writer.writerow({k: ("—" if v is None else v) for k, v in row.items()})
+
+
+def format_table(rows):
+    def fmt(value, digits=4):
+        return "—" if value is None else f"{value:.{digits}f}"
+
+    lines = [
+        f"{'task':40} {'tech':5} {'type':9} {'p':>4} {'time, s':>12} "
+        f"{'S':>8} {'E':>8} {'e(K-F)':>8}"
+    ]
+    for row in rows:
+        lines.append(
+            f"{row['task']:40} {row['technology']:5} {row['type_of_running']:9} "
+            f"{row['workers']:>4} {fmt(row['time_sec'], 6):>12} {fmt(row['speedup']):>8} "
+            f"{fmt(row['efficiency']):>8} {fmt(row['karp_flatt']):>8}"
+        )
+    return "\n".join(lines)
+
+
+def build_scaling_tables(paths, output_dir, mode, kind):
+    """Compute, print and save the scaling table; return the CSV path."""
+    rows = compute_scaling(load_records(paths), WORKER_KEYS[mode], kind)
+    print(format_table(rows), flush=True)
+    os.makedirs(output_dir, exist_ok=True)
+    csv_path = os.path.join(output_dir, f"{mode}_{kind}_scaling.csv")
+    write_csv(csv_path, rows)
+    return csv_path
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "-i",
+        "--input",
+        nargs="+",
+        required=True,
+        help="Perf record files (JSON Lines written via PPC_PERF_OUTPUT)",
+    )
+    parser.add_argument(
+        "-o", "--output", required=True, help="Output directory for the CSV table"
+    )
+    parser.add_argument(
+        "--mode",
+        choices=sorted(WORKER_KEYS),
+        default="processes",
+        help="Which worker count varies between records",
+    )
+    parser.add_argument("--kind", choices=SCALING_KINDS, default="strong")
+    args = parser.parse_args()
+    build_scaling_tables(args.input, args.output, args.mode, args.kind)
@@ -1,5 +1,89 @@
 #include "runners/include/runners.hpp"
 
+#ifdef PPC_USE_ALLOC_TRACKER
+#  include <cstddef>
+#  include <cstdlib>
+#  include <new>
+
+#  ifdef _WIN32
+#    include <malloc.h>
+#  endif
+
+#  include "performance/include/alloc_tracker.hpp"
+
+// Global allocation functions that feed ppc::performance::alloc_tracker. The array and nothrow forms forward
+// to these by default, so every heap allocation of the process is seen.
+namespace {
+
+void *AllocateOrThrow(std::size_t size, std::size_t alignment) {
+  ppc::performance::alloc_tracker::RecordAllocation(size);
+  if (size == 0) {
+    size = 1;
+  }
+  while (true) {
+    void *ptr = nullptr;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ptr = std::malloc(size);  // NOLINT(cppcoreguidelines-no-malloc)
+    } else {
+#  ifdef _WIN32
+      ptr = _aligned_malloc(size, alignment);
+#  else
+      ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#  endif
+    }
+    if (ptr != nullptr) {
+      return ptr;
+    }
+    const std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+  return AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept {
+  if (ptr != nullptr) {
+    ppc::performance::alloc_tracker::RecordDeallocation();
+  }
+  std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void operator delete(void *ptr, std::align_val_t alignment) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  ppc::performance::alloc_tracker::RecordDeallocation();
+  if (static_cast<std::size_t>(alignment) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc)
+  } else {
+#  ifdef _WIN32
+    _aligned_free(ptr);
+#  else
+    std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc)
+#  endif
+  }
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  ::operator delete(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/, std::align_val_t alignment) noexcept {
+  ::operator delete(ptr, alignment);
+}
+#endif
+
 int main(int argc, char **argv) {
   return ppc::runners::Init(argc, argv);
 }
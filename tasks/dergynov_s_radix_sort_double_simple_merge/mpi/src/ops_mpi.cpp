@@ -5,17 +5,20 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include "dergynov_s_radix_sort_double_simple_merge/common/include/common.hpp"
+#include "mpi/include/distribution.hpp"
+#include "mpi/include/shared_memory.hpp"
 
 namespace dergynov_s_radix_sort_double_simple_merge {
 namespace {
 
-void RadixSortDoubles(std::vector<double> &data) {
+std::vector<double> RadixSortDoubles(std::span<const double> data) {
   if (data.size() <= 1) {
-    return;
+    return {data.begin(), data.end()};
   }
 
   std::vector<uint64_t> keys(data.size());
@@ -48,9 +51,11 @@ void RadixSortDoubles(std::vector<double> &data) {
     keys.swap(temp);
   }
 
+  std::vector<double> sorted(data.size());
   for (size_t i = 0; i < data.size(); ++i) {
-    data[i] = SortableUint64ToDouble(keys[i]);
+    sorted[i] = SortableUint64ToDouble(keys[i]);
   }
+  return sorted;
 }
 
 std::vector<double> MergeSorted(const std::vector<double> &a, const std::vector<double> &b) {
@@ -101,29 +106,10 @@ bool DergynovSRadixSortDoubleSimpleMergeMPI::RunImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
   const auto &input = GetInput();
-  int n = static_cast<int>(input.size());
-
-  MPI_Bcast(&n, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  std::vector<int> counts(size);
-  std::vector<int> displs(size);
-
-  int base = n / size;
-  int rem = n % size;
-  int offset = 0;
-
-  for (int i = 0; i < size; ++i) {
-    counts[i] = base + (i < rem ? 1 : 0);
-    displs[i] = offset;
-    offset += counts[i];
-  }
-
-  std::vector<double> local_data(counts[rank]);
-
-  MPI_Scatterv(rank == 0 ? input.data() : nullptr, counts.data(), displs.data(), MPI_DOUBLE, local_data.data(),
-               counts[rank], MPI_DOUBLE, 0, MPI_COMM_WORLD);
-
-  RadixSortDoubles(local_data);
+  const std::size_t n = ppc::mpi::BroadcastSize(input.size());
+  const auto part = ppc::mpi::ScatterView(std::span<const double>(input), ppc::mpi::BlockDistribution(n, size));
+  // The keys are read straight from the (shared) part
+  std::vector<double> local_data = RadixSortDoubles(part.Get());
 
   if (rank == 0) {
     result_ = std::move(local_data);
@@ -3,9 +3,9 @@
 #include <mpi.h>
 
 #include <numeric>
-#include <vector>
 
 #include "example_processes_2/common/include/common.hpp"
+#include "task/include/scratch_arena.hpp"
 #include "util/include/util.hpp"
 
 namespace nesterov_a_test_task_processes_2 {
@@ -34,7 +34,7 @@ bool NesterovATestTaskMPI::RunImpl() {
   for (InType i = 0; i < GetInput(); i++) {
     for (InType j = 0; j < GetInput(); j++) {
       for (InType k = 0; k < GetInput(); k++) {
-        std::vector<InType> tmp(i + j + k, 1);
+        ppc::task::ScratchVector<InType> tmp(i + j + k, 1, &GetScratchArena());
         GetOutput() += std::accumulate(tmp.begin(), tmp.end(), 0);
         GetOutput() -= i + j + k;
       }
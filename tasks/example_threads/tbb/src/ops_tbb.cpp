@@ -5,10 +5,10 @@
 #include <atomic>
 #include <numeric>
 #include <util/include/util.hpp>
-#include <vector>
 
 #include "example_threads/common/include/common.hpp"
 #include "oneapi/tbb/parallel_for.h"
+#include "task/include/scratch_arena.hpp"
 
 namespace nesterov_a_test_task_threads {
 
@@ -31,7 +31,7 @@ bool NesterovATestTaskTBB::RunImpl() {
   for (InType i = 0; i < GetInput(); i++) {
     for (InType j = 0; j < GetInput(); j++) {
       for (InType k = 0; k < GetInput(); k++) {
-        std::vector<InType> tmp(i + j + k, 1);
+        ppc::task::ScratchVector<InType> tmp(i + j + k, 1, &GetScratchArena());
         GetOutput() += std::accumulate(tmp.begin(), tmp.end(), 0);
         GetOutput() -= i + j + k;
       }
@@ -23,14 +23,12 @@ class KamaletdinovRGaussVerticalSchemeMPI : public BaseTask {
   int FindPivotRow(int k, int cols);
   void SwapRows(int row1, int row2, int cols);
   void EliminateColumn(int k, int cols);
-  void SynchronizeRow(int k, int row, int cols);
+  void SynchronizeRows(int k, int cols);
   void BackSubstitution();
 
   void DistributeMatrixByStripes();
   void ReceiveMatrixStripe();
   void SynchronizeMatrixByStripes();
-  void ExchangeStripesForRow(int row);
-  void ExchangeStripeWithProcess(int row, int proc);
 
   int n_{0};
   std::vector<double> extended_matrix_;
@@ -8,9 +8,25 @@
 #include <vector>
 
 #include "kamaletdinov_r_gauss_vertical_scheme/kamaletdinov_r_gauss_vertical_scheme/common/include/common.hpp"
+#include "mpi/include/comm_cache.hpp"
 
 namespace kamaletdinov_r_gauss_vertical_scheme {
 
+namespace {
+
+/// Number of columns first, first + step, ... below width.
+int StripeWidth(int width, int first, int step) {
+  return first < width ? (width - first + step - 1) / step : 0;
+}
+
+/// One row of a vertical stripe; the extent of a full matrix row makes consecutive items walk down the rows.
+/// Only the step stripes starting at columns 0..step-1 are used, so the cache holds at most step types.
+MPI_Datatype StripeType(int width, int step, int cols) {
+  return width > 0 ? ppc::mpi::GetVectorType(width, 1, step, MPI_DOUBLE, cols) : MPI_DOUBLE;
+}
+
+}  // namespace
+
 KamaletdinovRGaussVerticalSchemeMPI::KamaletdinovRGaussVerticalSchemeMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
@@ -59,71 +75,32 @@ bool KamaletdinovRGaussVerticalSchemeMPI::PreProcessingImpl() {
 void KamaletdinovRGaussVerticalSchemeMPI::DistributeMatrixByStripes() {
   int cols = n_ + 1;
   for (int proc = 1; proc < size_; proc++) {
-    for (int i = 0; i < n_; i++) {
-      std::vector<double> stripe;
-      for (int j = proc; j < cols; j += size_) {
-        stripe.push_back(extended_matrix_[(i * cols) + j]);
-      }
-      MPI_Send(stripe.data(), static_cast<int>(stripe.size()), MPI_DOUBLE, proc, 0, MPI_COMM_WORLD);
+    int width = StripeWidth(cols, proc, size_);
+    if (width > 0) {
+      MPI_Send(extended_matrix_.data() + proc, n_, StripeType(width, size_, cols), proc, 0, MPI_COMM_WORLD);
     }
   }
 }
 
 void KamaletdinovRGaussVerticalSchemeMPI::ReceiveMatrixStripe() {
   int cols = n_ + 1;
-  for (int i = 0; i < n_; i++) {
-    int stripe_size = 0;
-    for (int j = rank_; j < cols; j += size_) {
-      stripe_size++;
-    }
-    std::vector<double> stripe(stripe_size);
-    MPI_Recv(stripe.data(), stripe_size, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-    int idx = 0;
-    for (int j = rank_; j < cols; j += size_) {
-      extended_matrix_[(i * cols) + j] = stripe[idx++];
-    }
+  int width = StripeWidth(cols, rank_, size_);
+  if (width > 0) {
+    MPI_Recv(extended_matrix_.data() + rank_, n_, StripeType(width, size_, cols), 0, 0, MPI_COMM_WORLD,
+             MPI_STATUS_IGNORE);
   }
 }
 
 void KamaletdinovRGaussVerticalSchemeMPI::SynchronizeMatrixByStripes() {
-  for (int i = 0; i < n_; i++) {
-    ExchangeStripesForRow(i);
-  }
-}
-
-void KamaletdinovRGaussVerticalSchemeMPI::ExchangeStripesForRow(int row) {
-  for (int proc = 0; proc < size_; proc++) {
-    if (proc != rank_) {
-      ExchangeStripeWithProcess(row, proc);
-    }
-  }
-}
-
-void KamaletdinovRGaussVerticalSchemeMPI::ExchangeStripeWithProcess(int row, int proc) {
   int cols = n_ + 1;
-  std::vector<double> my_stripe;
-  for (int j = rank_; j < cols; j += size_) {
-    my_stripe.push_back(extended_matrix_[(row * cols) + j]);
-  }
-
-  int recv_size = 0;
-  for (int j = proc; j < cols; j += size_) {
-    recv_size++;
-  }
-  std::vector<double> recv_stripe(recv_size);
-
-  if (rank_ < proc) {
-    MPI_Send(my_stripe.data(), static_cast<int>(my_stripe.size()), MPI_DOUBLE, proc, row, MPI_COMM_WORLD);
-    MPI_Recv(recv_stripe.data(), recv_size, MPI_DOUBLE, proc, row, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-  } else {
-    MPI_Recv(recv_stripe.data(), recv_size, MPI_DOUBLE, proc, row, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    MPI_Send(my_stripe.data(), static_cast<int>(my_stripe.size()), MPI_DOUBLE, proc, row, MPI_COMM_WORLD);
-  }
-
-  int idx = 0;
-  for (int j = proc; j < cols; j += size_) {
-    extended_matrix_[(row * cols) + j] = recv_stripe[idx++];
+  int my_width = StripeWidth(cols, rank_, size_);
+  for (int step = 1; step < size_; step++) {
+    int dest = (rank_ + step) % size_;
+    int source = (rank_ - step + size_) % size_;
+    int source_width = StripeWidth(cols, source, size_);
+    MPI_Sendrecv(extended_matrix_.data() + rank_, my_width > 0 ? n_ : 0, StripeType(my_width, size_, cols), dest, 0,
+                 extended_matrix_.data() + source, source_width > 0 ? n_ : 0, StripeType(source_width, size_, cols),
+                 source, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
   }
 }
 
@@ -146,33 +123,29 @@ void KamaletdinovRGaussVerticalSchemeMPI::SwapRows(int row1, int row2, int cols)
   }
 }
 
-void KamaletdinovRGaussVerticalSchemeMPI::SynchronizeRow(int k, int row, int cols) {
-  std::vector<double> row_data(cols - k);
-  for (int j = k; j < cols; j++) {
-    row_data[j - k] = extended_matrix_[(row * cols) + j];
+void KamaletdinovRGaussVerticalSchemeMPI::SynchronizeRows(int k, int cols) {
+  int rows = n_ - k - 1;
+  if (rows <= 0) {
+    return;
   }
-
+  double *block = extended_matrix_.data() + (static_cast<std::size_t>(k + 1) * cols);
+  // Rank p updated columns k + p, k + p + size_, ... It sends that whole stripe from column (k + p) % size_ on:
+  // the columns left of k are the same on every rank, and the stripe type does not depend on k
   if (rank_ == 0) {
     for (int proc = 1; proc < size_; proc++) {
-      std::vector<double> recv_data(cols - k);
-      MPI_Recv(recv_data.data(), cols - k, MPI_DOUBLE, proc, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-      for (int j = k + proc; j < cols; j += size_) {
-        row_data[j - k] = recv_data[j - k];
+      int first = (k + proc) % size_;
+      if (k + proc < cols) {
+        MPI_Recv(block + first, rows, StripeType(StripeWidth(cols, first, size_), size_, cols), proc, 0,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
       }
     }
-    for (int j = k; j < cols; j++) {
-      extended_matrix_[(row * cols) + j] = row_data[j - k];
-    }
-    for (int proc = 1; proc < size_; proc++) {
-      MPI_Send(row_data.data(), cols - k, MPI_DOUBLE, proc, 1, MPI_COMM_WORLD);
-    }
   } else {
-    MPI_Send(row_data.data(), cols - k, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
-    MPI_Recv(row_data.data(), cols - k, MPI_DOUBLE, 0, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    for (int j = k; j < cols; j++) {
-      extended_matrix_[(row * cols) + j] = row_data[j - k];
+    int first = (k + rank_) % size_;
+    if (k + rank_ < cols) {
+      MPI_Send(block + first, rows, StripeType(StripeWidth(cols, first, size_), size_, cols), 0, 0, MPI_COMM_WORLD);
     }
   }
+  MPI_Bcast(block, rows * cols, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 }
 
 void KamaletdinovRGaussVerticalSchemeMPI::EliminateColumn(int k, int cols) {
@@ -194,9 +167,7 @@ void KamaletdinovRGaussVerticalSchemeMPI::EliminateColumn(int k, int cols) {
   }
 
   if (size_ > 1) {
-    for (int i = k + 1; i < n_; i++) {
-      SynchronizeRow(k, i, cols);
-    }
+    SynchronizeRows(k, cols);
   }
 }
 
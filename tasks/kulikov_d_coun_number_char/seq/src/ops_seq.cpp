@@ -2,14 +2,15 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <utility>
 
 #include "kulikov_d_coun_number_char/common/include/common.hpp"
 
 namespace kulikov_d_coun_number_char {
 
-KulikovDiffCountNumberCharSEQ::KulikovDiffCountNumberCharSEQ(const InType &in) {
+KulikovDiffCountNumberCharSEQ::KulikovDiffCountNumberCharSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
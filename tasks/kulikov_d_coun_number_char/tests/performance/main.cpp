@@ -39,7 +39,8 @@ class KulikovDiffCountNumberCharPerfTests : public ppc::util::BaseRunPerfTests<I
   }
 
   InType GetTestInputData() final {
-    return input_data;
+    // Only expected_result is needed for the check, so the strings are handed over instead of copied
+    return std::move(input_data);
   }
 };
 
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <mpi.h>
 
+#include <cstddef>
+
 #include "likhanov_m_elem_vec_sum/common/include/common.hpp"
 #include "likhanov_m_elem_vec_sum/mpi/include/ops_mpi.hpp"
 #include "likhanov_m_elem_vec_sum/seq/include/ops_seq.hpp"
@@ -11,6 +13,7 @@ namespace likhanov_m_elem_vec_sum {
 class LikhanovMElemVecSumRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
  protected:
   static constexpr InType kCount = 100'000'000;
+  static constexpr std::size_t kCountPerWorker = 25'000'000;
   InType input_data{};
 
   void SetUp() override {
@@ -21,6 +24,14 @@ class LikhanovMElemVecSumRunPerfTests : public ppc::util::BaseRunPerfTests<InTyp
     return input_data;
   }
 
+  std::size_t GetWeakScalingSizePerWorker() final {
+    return kCountPerWorker;
+  }
+
+  void SetUpWeakScaling(std::size_t size_per_worker, std::size_t num_workers) final {
+    input_data = static_cast<InType>(size_per_worker * num_workers);
+  }
+
   bool CheckTestOutputData(OutType &output_data) final {
     int mpi_initialized = 0;
     MPI_Initialized(&mpi_initialized);
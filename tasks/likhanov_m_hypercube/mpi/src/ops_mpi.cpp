@@ -2,10 +2,10 @@
 
 #include <mpi.h>
 
-#include <cmath>
 #include <cstdint>
 
 #include "likhanov_m_hypercube/common/include/common.hpp"
+#include "mpi/include/collectives.hpp"
 
 namespace likhanov_m_hypercube {
 
@@ -38,7 +38,6 @@ bool LikhanovMHypercubeMPI::RunImpl() {
     return false;
   }
 
-  const int dimension = static_cast<int>(std::log2(size));
   const InType n = GetInput();
 
   const std::uint64_t vertices = static_cast<std::uint64_t>(1) << n;
@@ -55,25 +54,9 @@ bool LikhanovMHypercubeMPI::RunImpl() {
 
   const std::uint64_t end = start + local_size;
 
-  std::uint64_t local_edges = ComputeLocalEdges(start, end, n);
+  const std::uint64_t local_edges = ComputeLocalEdges(start, end, n);
 
-  std::uint64_t sum = local_edges;
-
-  for (int k = 0; k < dimension; ++k) {
-    int partner = rank ^ (1 << k);
-
-    if ((rank & (1 << k)) != 0) {
-      MPI_Send(&sum, 1, MPI_UINT64_T, partner, 0, MPI_COMM_WORLD);
-      break;
-    }
-    if (partner < size) {
-      std::uint64_t received = 0;
-      MPI_Recv(&received, 1, MPI_UINT64_T, partner, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-      sum += received;
-    }
-  }
-
-  MPI_Bcast(&sum, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+  const std::uint64_t sum = ppc::mpi::coll::Allreduce(local_edges, MPI_SUM);
 
   GetOutput() = static_cast<OutType>(sum);
 
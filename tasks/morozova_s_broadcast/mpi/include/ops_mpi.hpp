@@ -1,7 +1,5 @@
 #pragma once
 
-#include <mpi.h>
-
 #include "morozova_s_broadcast/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -24,8 +22,6 @@ class MorozovaSBroadcastMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
-  static void CustomBroadcast(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm);
-
   int root_;
 };
 
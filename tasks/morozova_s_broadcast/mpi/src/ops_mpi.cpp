@@ -4,8 +4,10 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <span>
 
 #include "morozova_s_broadcast/common/include/common.hpp"
+#include "mpi/include/collectives.hpp"
 #include "task/include/task.hpp"
 
 namespace morozova_s_broadcast {
@@ -49,13 +51,13 @@ bool MorozovaSBroadcastMPI::RunImpl() {
   if (rank == root_) {
     data_size = static_cast<int>(GetInput().size());
   }
-  CustomBroadcast(&data_size, 1, MPI_INT, root_, MPI_COMM_WORLD);
+  ppc::mpi::coll::Bcast(std::span<int>(&data_size, 1), root_);
   GetOutput().resize(static_cast<size_t>(data_size));
   if (data_size > 0) {
     if (rank == root_) {
       std::copy(GetInput().begin(), GetInput().end(), GetOutput().begin());
     }
-    CustomBroadcast(GetOutput().data(), data_size, MPI_INT, root_, MPI_COMM_WORLD);
+    ppc::mpi::coll::Bcast(std::span<int>(GetOutput()), root_);
   }
   return true;
 }
@@ -64,28 +66,4 @@ bool MorozovaSBroadcastMPI::PostProcessingImpl() {
   return true;
 }
 
-void MorozovaSBroadcastMPI::CustomBroadcast(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm) {
-  int rank = 0;
-  int size = 0;
-  MPI_Comm_rank(comm, &rank);
-  MPI_Comm_size(comm, &size);
-  if (size <= 1) {
-    return;
-  }
-  int vrank = (rank - root + size) % size;
-  for (int step = 1; step < size; step <<= 1) {
-    if (vrank < step) {
-      int dst_vrank = vrank + step;
-      if (dst_vrank < size) {
-        int dst_rank = (dst_vrank + root) % size;
-        MPI_Send(buffer, count, type, dst_rank, 0, comm);
-      }
-    } else if (vrank < 2 * step) {
-      int src_vrank = vrank - step;
-      int src_rank = (src_vrank + root) % size;
-      MPI_Recv(buffer, count, type, src_rank, 0, comm, MPI_STATUS_IGNORE);
-    }
-  }
-}
-
 }  // namespace morozova_s_broadcast
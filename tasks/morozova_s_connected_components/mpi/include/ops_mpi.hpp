@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "morozova_s_connected_components/common/include/common.hpp"
+#include "task/include/scratch_arena.hpp"
 #include "task/include/task.hpp"
 
 namespace morozova_s_connected_components {
@@ -24,7 +25,7 @@ class MorozovaSConnectedComponentsMPI : public BaseTask {
   bool PostProcessingImpl() override;
 
   void FloodFill(int row, int col, int label);
-  std::vector<std::pair<int, int>> GetNeighbors(int row, int col);
+  ppc::task::ScratchVector<std::pair<int, int>> GetNeighbors(int row, int col);
 
   void InitMPI();
   [[nodiscard]] std::pair<int, int> ComputeRowRange() const;
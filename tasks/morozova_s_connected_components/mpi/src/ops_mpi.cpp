@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "morozova_s_connected_components/common/include/common.hpp"
+#include "task/include/scratch_arena.hpp"
 
 namespace morozova_s_connected_components {
 
@@ -81,8 +82,9 @@ std::pair<int, int> MorozovaSConnectedComponentsMPI::ComputeRowRange() const {
   return {start, end};
 }
 
-std::vector<std::pair<int, int>> MorozovaSConnectedComponentsMPI::GetNeighbors(int row, int col) {
-  std::vector<std::pair<int, int>> neighbors;
+ppc::task::ScratchVector<std::pair<int, int>> MorozovaSConnectedComponentsMPI::GetNeighbors(int row, int col) {
+  ppc::task::ScratchVector<std::pair<int, int>> neighbors(&GetScratchArena());
+  neighbors.reserve(kShifts.size());
   const auto &input = GetInput();
   for (const auto &[dr, dc] : kShifts) {
     const int nr = row + dr;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "morozova_s_matrix_max_value/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -17,6 +19,9 @@ class MorozovaSMatrixMaxValueMPI : public BaseTask {
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
+
+  // Row-major copy of the matrix on the root, built outside the timed Run()
+  std::vector<int> flat_;
 };
 
 }  // namespace morozova_s_matrix_max_value
@@ -4,9 +4,13 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <span>
 #include <vector>
 
 #include "morozova_s_matrix_max_value/common/include/common.hpp"
+#include "mpi/include/distribution.hpp"
+#include "mpi/include/pipeline.hpp"
 
 namespace morozova_s_matrix_max_value {
 
@@ -29,49 +33,34 @@ bool MorozovaSMatrixMaxValueMPI::ValidationImpl() {
 }
 
 bool MorozovaSMatrixMaxValueMPI::PreProcessingImpl() {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  const auto &matrix = GetInput();
+  flat_.clear();
+  // Only the root scatters; the buffer keeps its capacity, so later pipeline runs refill it without reallocating
+  if (rank == 0 && !matrix.empty()) {
+    flat_.reserve(matrix.size() * matrix[0].size());
+    for (const auto &row : matrix) {
+      flat_.insert(flat_.end(), row.begin(), row.end());
+    }
+  }
   return true;
 }
 
 bool MorozovaSMatrixMaxValueMPI::RunImpl() {
-  int rank = 0;
   int size = 1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
   const auto &matrix = GetInput();
   if (matrix.empty() || matrix[0].empty()) {
     GetOutput() = 0;
     return true;
   }
-  const int rows = static_cast<int>(matrix.size());
-  const int cols = static_cast<int>(matrix[0].size());
-  const int total = rows * cols;
-  std::vector<int> flat;
-  if (rank == 0) {
-    flat.reserve(total);
-    for (const auto &row : matrix) {
-      flat.insert(flat.end(), row.begin(), row.end());
-    }
-  }
-  std::vector<int> counts(size);
-  std::vector<int> displs(size);
-  const int base = total / size;
-  const int rest = total % size;
-  for (int i = 0, off = 0; i < size; ++i) {
-    counts[i] = base + static_cast<int>(i < rest);
-    displs[i] = off;
-    off += counts[i];
-  }
-  std::vector<int> local(counts[rank]);
-  MPI_Scatterv(rank == 0 ? flat.data() : nullptr, counts.data(), displs.data(), MPI_INT, local.data(), counts[rank],
-               MPI_INT, 0, MPI_COMM_WORLD);
-
-  int local_max = local[0];
-  for (int v : local) {
-    local_max = std::max(local_max, v);
-  }
-  int global_max = 0;
-  MPI_Allreduce(&local_max, &global_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
-  GetOutput() = global_max;
+  const auto distribution = ppc::mpi::BlockDistribution(matrix.size() * matrix[0].size(), size);
+  const auto chunk_max = [](int acc, std::span<const int> chunk) {
+    return chunk.empty() ? acc : std::max(acc, std::ranges::max(chunk));
+  };
+  GetOutput() = ppc::mpi::PipelinedScatterReduce(std::span<const int>(flat_), distribution,
+                                                 std::numeric_limits<int>::min(), chunk_max, MPI_MAX);
   return true;
 }
 
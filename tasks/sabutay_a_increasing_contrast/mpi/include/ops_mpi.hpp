@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include "sabutay_a_increasing_contrast/common/include/common.hpp"
@@ -20,10 +21,9 @@ class SabutayAIncreaseContrastMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
-  std::vector<unsigned char> ScatterInputData(int rank, int size, int data_len);
-  static void FindGlobalMinMax(const std::vector<unsigned char> &proc_part, unsigned char *data_min,
+  static void FindGlobalMinMax(std::span<const unsigned char> proc_part, unsigned char *data_min,
                                unsigned char *data_max);
-  static std::vector<unsigned char> ApplyContrast(const std::vector<unsigned char> &proc_part, unsigned char data_min,
+  static std::vector<unsigned char> ApplyContrast(std::span<const unsigned char> proc_part, unsigned char data_min,
                                                   unsigned char data_max);
 };
 
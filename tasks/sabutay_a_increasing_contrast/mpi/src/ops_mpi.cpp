@@ -4,8 +4,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <span>
 #include <vector>
 
+#include "mpi/include/distribution.hpp"
+#include "mpi/include/shared_memory.hpp"
 #include "sabutay_a_increasing_contrast/common/include/common.hpp"
 
 namespace sabutay_a_increasing_contrast {
@@ -30,71 +34,28 @@ bool SabutayAIncreaseContrastMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  int data_len = 0;
-  if (rank == 0) {
-    data_len = static_cast<int>(GetInput().size());
-  }
-
   // Рассылаем процессам размер данных
-  MPI_Bcast(&data_len, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  const std::size_t data_len = ppc::mpi::BroadcastSize(rank == 0 ? GetInput().size() : 0);
+  const auto distribution = ppc::mpi::BlockDistribution(data_len, size);
 
-  // Раздаем локальные данные всем процессам
-  std::vector<unsigned char> proc_part = ScatterInputData(rank, size, data_len);
+  // Раздаем локальные данные всем процессам (на одном узле - через общую память без копирования)
+  const auto proc_part = ppc::mpi::ScatterView(std::span<const unsigned char>(GetInput()), distribution);
 
   // Узнаем максимальное и минимальное значение пикселей и сообщаем об этом всем процессам
   unsigned char data_min = 0;
   unsigned char data_max = 0;
-  FindGlobalMinMax(proc_part, &data_min, &data_max);
+  FindGlobalMinMax(proc_part.Get(), &data_min, &data_max);
 
   // Преобразование пикселей процессами
-  std::vector<unsigned char> local_output = ApplyContrast(proc_part, data_min, data_max);
-
-  // Получаем данные о частях
-  int local_size = data_len / size;
-  int remainder = data_len % size;
-  std::vector<int> counts(size);
-  std::vector<int> step(size);
-  int start = 0;
-  for (int i = 0; i < size; ++i) {
-    counts[i] = local_size + (i < remainder ? 1 : 0);
-    step[i] = start;
-    start += counts[i];
-  }
+  std::vector<unsigned char> local_output = ApplyContrast(proc_part.Get(), data_min, data_max);
 
   // Рассылаем результат всем процессам
-  GetOutput().resize(data_len);
-  MPI_Allgatherv(local_output.data(), static_cast<int>(local_output.size()), MPI_UNSIGNED_CHAR, GetOutput().data(),
-                 counts.data(), step.data(), MPI_UNSIGNED_CHAR, MPI_COMM_WORLD);
+  GetOutput() = ppc::mpi::Allgather(std::span<const unsigned char>(local_output), distribution);
 
   return true;
 }
 
-std::vector<unsigned char> SabutayAIncreaseContrastMPI::ScatterInputData(int rank, int size, int data_len) {
-  int local_size = data_len / size;
-  int remainder = data_len % size;
-  int my_size = local_size + (rank < remainder ? 1 : 0);
-
-  std::vector<int> counts(size);
-  std::vector<int> step(size);
-  int start = 0;
-  for (int i = 0; i < size; ++i) {
-    counts[i] = local_size + (i < remainder ? 1 : 0);
-    step[i] = start;
-    start += counts[i];
-  }
-
-  std::vector<unsigned char> proc_part(my_size);
-  if (rank == 0) {
-    MPI_Scatterv(GetInput().data(), counts.data(), step.data(), MPI_UNSIGNED_CHAR, proc_part.data(), my_size,
-                 MPI_UNSIGNED_CHAR, 0, MPI_COMM_WORLD);
-  } else {
-    MPI_Scatterv(nullptr, nullptr, nullptr, MPI_UNSIGNED_CHAR, proc_part.data(), my_size, MPI_UNSIGNED_CHAR, 0,
-                 MPI_COMM_WORLD);
-  }
-  return proc_part;
-}
-
-void SabutayAIncreaseContrastMPI::FindGlobalMinMax(const std::vector<unsigned char> &proc_part, unsigned char *data_min,
+void SabutayAIncreaseContrastMPI::FindGlobalMinMax(std::span<const unsigned char> proc_part, unsigned char *data_min,
                                                    unsigned char *data_max) {
   unsigned char local_min = 255;
   unsigned char local_max = 0;
@@ -107,7 +68,7 @@ void SabutayAIncreaseContrastMPI::FindGlobalMinMax(const std::vector<unsigned ch
   MPI_Allreduce(&local_max, data_max, 1, MPI_UNSIGNED_CHAR, MPI_MAX, MPI_COMM_WORLD);
 }
 
-std::vector<unsigned char> SabutayAIncreaseContrastMPI::ApplyContrast(const std::vector<unsigned char> &proc_part,
+std::vector<unsigned char> SabutayAIncreaseContrastMPI::ApplyContrast(std::span<const unsigned char> proc_part,
                                                                       unsigned char data_min, unsigned char data_max) {
   int my_size = static_cast<int>(proc_part.size());
   std::vector<unsigned char> local_output(my_size);
@@ -1,11 +1,14 @@
 #include <gtest/gtest.h>
 
 #include <cstddef>
+#include <cstdint>
+#include <span>
 
 #include "sabutay_a_increasing_contrast/common/include/common.hpp"
 #include "sabutay_a_increasing_contrast/mpi/include/ops_mpi.hpp"
 #include "sabutay_a_increasing_contrast/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace sabutay_a_increasing_contrast {
 
@@ -15,10 +18,9 @@ class SabutayAIncreaseContrastPerfTests : public ppc::util::BaseRunPerfTests<InT
 
   void SetUp() override {
     input_data_.resize(kPixelsCount_);
-    for (size_t i = 0; i < kPixelsCount_; i++) {
-      // повторяющийся блок от 100 до 150
-      input_data_[i] = static_cast<unsigned char>(100 + (i % 51));
-    }
+    // повторяющийся блок от 100 до 150
+    ppc::util::ParallelFill(std::span<unsigned char>(input_data_), 0,
+                            [](uint64_t i) { return static_cast<unsigned char>(100 + (i % 51)); });
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "mpi/include/shared_memory.hpp"
 #include "sabutay_a_radix_sort_double_with_merge/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -25,9 +26,8 @@ class SabutayAradixSortDoubleWithMergeMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
+  ppc::mpi::LocalPart<double> part_;
   std::vector<double> local_;
-  std::vector<int> counts_;
-  std::vector<int> displs_;
   int world_rank_{0};
   int world_size_{1};
 };
@@ -7,8 +7,12 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
+#include "mpi/include/distribution.hpp"
+#include "mpi/include/shared_memory.hpp"
+
 namespace sabutay_a_radix_sort_double_with_merge {
 
 namespace {
@@ -25,19 +29,21 @@ inline uint64_t DoubleToOrderedKey(double x) {
   return bits ^ (1ULL << 63U);
 }
 
-void RadixSortDouble(std::vector<double> *vec) {
-  auto &a = *vec;
-  const std::size_t n = a.size();
+std::vector<double> RadixSortDouble(std::span<const double> in) {
+  const std::size_t n = in.size();
   if (n <= 1) {
-    return;
+    return {in.begin(), in.end()};
   }
 
+  // The first pass reads the values straight from the input, later ones from the previous pass
+  std::span<const double> src = in;
+  std::vector<double> a(n);
   std::vector<double> out(n);
   std::vector<uint64_t> keys(n);
   std::vector<uint64_t> out_keys(n);
 
   for (std::size_t i = 0; i < n; ++i) {
-    keys[i] = DoubleToOrderedKey(a[i]);
+    keys[i] = DoubleToOrderedKey(in[i]);
   }
 
   for (std::size_t pass = 0; pass < 8; ++pass) {
@@ -58,13 +64,15 @@ void RadixSortDouble(std::vector<double> *vec) {
     for (std::size_t i = 0; i < n; ++i) {
       const auto byte = static_cast<unsigned>((keys[i] >> shift) & 0xFFULL);
       const std::size_t p = pos.at(static_cast<std::size_t>(byte))++;
-      out[p] = a[i];
+      out[p] = src[i];
       out_keys[p] = keys[i];
     }
 
     a.swap(out);
+    src = a;
     keys.swap(out_keys);
   }
+  return a;
 }
 
 std::vector<double> MergeSorted(const std::vector<double> &a, const std::vector<double> &b) {
@@ -126,41 +134,17 @@ bool SabutayAradixSortDoubleWithMergeMPI::PreProcessingImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &world_rank_);
   MPI_Comm_size(MPI_COMM_WORLD, &world_size_);
 
-  int global_size = 0;
-  if (world_rank_ == 0) {
-    global_size = static_cast<int>(GetInput().size());
-  }
-  MPI_Bcast(&global_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  counts_.assign(world_size_, 0);
-  displs_.assign(world_size_, 0);
-
-  const int base = (world_size_ > 0) ? (global_size / world_size_) : 0;
-  const int rem = (world_size_ > 0) ? (global_size % world_size_) : 0;
-
-  for (int rank_idx = 0; rank_idx < world_size_; ++rank_idx) {
-    counts_[rank_idx] = base + ((rank_idx < rem) ? 1 : 0);
-  }
-  for (int rank_idx = 1; rank_idx < world_size_; ++rank_idx) {
-    displs_[rank_idx] = displs_[rank_idx - 1] + counts_[rank_idx - 1];
-  }
-
-  local_.assign(static_cast<std::size_t>(counts_[world_rank_]), 0.0);
-
-  double *send_buf = nullptr;
-  if (world_rank_ == 0 && global_size > 0) {
-    send_buf = GetInput().data();
-  }
-
-  MPI_Scatterv(send_buf, counts_.data(), displs_.data(), MPI_DOUBLE, local_.data(), counts_[world_rank_], MPI_DOUBLE, 0,
-               MPI_COMM_WORLD);
+  const std::size_t global_size = ppc::mpi::BroadcastSize(world_rank_ == 0 ? GetInput().size() : 0);
+  // On one node the part stays in shared memory until the sort's first pass reads it
+  part_ = ppc::mpi::ScatterView(std::span<const double>(GetInput()),
+                                ppc::mpi::BlockDistribution(global_size, world_size_));
 
   GetOutput().clear();
   return true;
 }
 
 bool SabutayAradixSortDoubleWithMergeMPI::RunImpl() {
-  RadixSortDouble(&local_);
+  local_ = RadixSortDouble(part_.Get());
 
   for (int step = 1; step < world_size_; step <<= 1) {
     if ((world_rank_ % (2 * step)) == 0) {
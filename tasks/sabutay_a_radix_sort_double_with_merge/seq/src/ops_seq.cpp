@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "sabutay_a_radix_sort_double_with_merge/common/include/common.hpp"
@@ -74,6 +75,8 @@ void RadixSortDouble(std::vector<double> *vec) {
 SabutayAradixSortDoubleWithMergeSEQ::SabutayAradixSortDoubleWithMergeSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
+  // PreProcessing takes the input over instead of copying it; the snapshot lets the pipeline be repeated
+  SnapshotInput();
   GetOutput() = {};
 }
 
@@ -82,7 +85,7 @@ bool SabutayAradixSortDoubleWithMergeSEQ::ValidationImpl() {
 }
 
 bool SabutayAradixSortDoubleWithMergeSEQ::PreProcessingImpl() {
-  data_ = GetInput();
+  data_ = std::move(GetInput());
   GetOutput().clear();
   return true;
 }
@@ -93,7 +96,7 @@ bool SabutayAradixSortDoubleWithMergeSEQ::RunImpl() {
 }
 
 bool SabutayAradixSortDoubleWithMergeSEQ::PostProcessingImpl() {
-  GetOutput() = data_;
+  GetOutput().swap(data_);
   return true;
 }
 
@@ -5,23 +5,18 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include "sabutay_a_radix_sort_double_with_merge/common/include/common.hpp"
 #include "sabutay_a_radix_sort_double_with_merge/mpi/include/ops_mpi.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace sabutay_a_radix_sort_double_with_merge {
 
 namespace {
 
-double NextRandDouble(uint32_t *state) {
-  *state = (*state * 1103515245U) + 12345U;
-  const uint32_t x = *state;
-  const double u = static_cast<double>(x) / static_cast<double>(UINT32_MAX);
-  return (u * 2.0 - 1.0) * 1.0e6;
-}
-
 inline uint64_t DoubleToOrderedKey(double x) {
   if (std::isnan(x)) {
     return UINT64_MAX;
@@ -84,10 +79,9 @@ class RastvorovKRadixSortDoubleMergeRunPerfTestProcesses : public ppc::util::Bas
     constexpr std::size_t kSize = 200000;
     input_data_.resize(kSize);
 
-    uint32_t state = 17U;
-    for (std::size_t i = 0; i < kSize; ++i) {
-      input_data_[i] = NextRandDouble(&state);
-    }
+    const ppc::util::CounterRng<> rng(17);
+    ppc::util::ParallelFill(std::span<double>(input_data_), 0,
+                            [&rng](uint64_t i) { return rng.UniformReal(i, -1.0e6, 1.0e6); });
 
     expected_ = input_data_;
     RadixSortDouble(&expected_);
@@ -10,7 +10,11 @@ class ShkrylevaSVecMinValMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ShkrylevaSVecMinValMPI(const InType &in);
+  // Only rank 0 reads the input before scattering it
+  static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+    return ppc::task::InputResidency::kRootOnly;
+  }
+  explicit ShkrylevaSVecMinValMPI(InType in);
 
  private:
   bool ValidationImpl() override;
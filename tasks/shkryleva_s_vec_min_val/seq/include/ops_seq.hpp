@@ -10,7 +10,7 @@ class ShkrylevaSVecMinValSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ShkrylevaSVecMinValSEQ(const InType &in);
+  explicit ShkrylevaSVecMinValSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -3,15 +3,16 @@
 #include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "shkryleva_s_vec_min_val/common/include/common.hpp"
 
 namespace shkryleva_s_vec_min_val {
 
-ShkrylevaSVecMinValSEQ::ShkrylevaSVecMinValSEQ(const InType &in) {
+ShkrylevaSVecMinValSEQ::ShkrylevaSVecMinValSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -1,11 +1,14 @@
 #include <gtest/gtest.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <random>
+#include <span>
 
 #include "shkryleva_s_vec_min_val/common/include/common.hpp"
 #include "shkryleva_s_vec_min_val/mpi/include/ops_mpi.hpp"
 #include "shkryleva_s_vec_min_val/seq/include/ops_seq.hpp"
+#include "util/include/data_cache.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace shkryleva_s_vec_min_val {
@@ -13,33 +16,48 @@ namespace shkryleva_s_vec_min_val {
 class ShkrylevaSVecMinValPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
  public:
   static constexpr size_t kVectorSize = 100000000;
+  static constexpr size_t kVectorSizePerWorker = 25000000;
+  static constexpr OutType kExpectedMin = -1500;
+  static constexpr uint64_t kSeed = 42;
 
  protected:
   void SetUp() override {
-    std::random_device dev;
-    std::mt19937 gen(dev());
-    std::uniform_int_distribution<int> dist(-1000, 1000);
+    input_size_ = kVectorSize;
+  }
 
-    input_data_.resize(kVectorSize);
-    for (size_t i = 0; i < kVectorSize; i++) {
-      input_data_[i] = dist(gen);
-    }
+  auto GetWeakScalingSizePerWorker() -> size_t final {
+    return kVectorSizePerWorker;
+  }
 
-    expected_min_ = -1500;
-    input_data_[kVectorSize / 2] = expected_min_;
+  void SetUpWeakScaling(size_t size_per_worker, size_t num_workers) final {
+    input_size_ = size_per_worker * num_workers;
   }
 
   auto CheckTestOutputData(OutType &output_data) -> bool final {
-    return expected_min_ == output_data;
+    return kExpectedMin == output_data;
   }
 
+  // The vector is built on demand, so ranks that do not hold the MPI task's input never allocate it.
+  // The random values are generated once and then mapped from the data cache by later runs and other ranks.
   auto GetTestInputData() -> InType final {
-    return input_data_;
+    const ppc::util::DataCacheKey key{
+        .task_id = "shkryleva_s_vec_min_val", .generator = "uniform_int_v1", .shape = {input_size_}, .seed = kSeed};
+    const auto dataset = ppc::util::GetOrCreateCachedDataset<int>(key, [](std::span<int> values) {
+      std::mt19937 gen(kSeed);
+      std::uniform_int_distribution<int> dist(-1000, 1000);
+      for (int &value : values) {
+        value = dist(gen);
+      }
+    });
+
+    const auto values = dataset.View<int>();
+    InType input_data(values.begin(), values.end());
+    input_data[input_size_ / 2] = kExpectedMin;
+    return input_data;
   }
 
  private:
-  InType input_data_;
-  OutType expected_min_{};
+  size_t input_size_ = 0;
 };
 
 TEST_P(ShkrylevaSVecMinValPerfTests, RunPerfModes) {
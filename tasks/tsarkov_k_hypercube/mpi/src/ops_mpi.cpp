@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "mpi/include/comm_cache.hpp"
 #include "tsarkov_k_hypercube/common/include/common.hpp"
 
 namespace tsarkov_k_hypercube {
@@ -78,10 +79,8 @@ void InitPayloadIfSource(const int world_rank, const int source_rank, const int
 [[nodiscard]] bool RouteOneDimension(const int world_rank, const int destination_rank, const int dim_index,
                                      std::vector<std::int32_t> *payload_buffer, bool *has_payload) {
   const int bit_mask = (1 << dim_index);
-  const int color_value = world_rank & ~bit_mask;
-
-  MPI_Comm dim_comm = MPI_COMM_NULL;
-  MPI_Comm_split(MPI_COMM_WORLD, color_value, world_rank, &dim_comm);
+  // Owned by the cache: split once, reused by every later run
+  MPI_Comm dim_comm = ppc::mpi::GetHypercubeComm(MPI_COMM_WORLD, dim_index);
 
   int dim_rank = 0;
   int dim_size = 0;
@@ -89,7 +88,6 @@ void InitPayloadIfSource(const int world_rank, const int source_rank, const int
   MPI_Comm_size(dim_comm, &dim_size);
 
   if (dim_size != 2) {
-    MPI_Comm_free(&dim_comm);
     return false;
   }
 
@@ -121,7 +119,6 @@ void InitPayloadIfSource(const int world_rank, const int source_rank, const int
     *has_payload = true;
   }
 
-  MPI_Comm_free(&dim_comm);
   return true;
 }
 
@@ -6,8 +6,10 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <span>
 #include <vector>
 
+#include "mpi/include/distribution.hpp"
 #include "yushkova_p_min_in_matrix/common/include/common.hpp"
 
 namespace yushkova_p_min_in_matrix {
@@ -49,13 +51,12 @@ bool YushkovaPMinInMatrixMPI::RunImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &world_size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  int base_rows = n / world_size;
-  int extra = n % world_size;
+  // Every rank writes the minima of its rows straight into the output and the rows are then shared in place
+  const auto distribution = ppc::mpi::BlockDistribution(static_cast<std::size_t>(n), world_size);
+  const auto my_start = static_cast<int>(distribution.displs[static_cast<std::size_t>(rank)]);
+  const auto my_count = static_cast<int>(distribution.counts[static_cast<std::size_t>(rank)]);
 
-  int my_start = (rank * base_rows) + std::min(rank, extra);
-  int my_count = base_rows + (rank < extra ? 1 : 0);
-
-  std::vector<int> local_results(my_count);
+  auto &output = GetOutput();
   for (int i = 0; i < my_count; ++i) {
     int current_row = my_start + i;
     int row_min = std::numeric_limits<int>::max();
@@ -64,21 +65,10 @@ bool YushkovaPMinInMatrixMPI::RunImpl() {
       int val = GenerateValue(current_row, j);
       row_min = std::min(row_min, val);
     }
-    local_results[i] = row_min;
-  }
-
-  std::vector<int> recv_counts(world_size);
-  std::vector<int> offsets(world_size);
-
-  int current_offset = 0;
-  for (int i = 0; i < world_size; ++i) {
-    recv_counts[i] = base_rows + (i < extra ? 1 : 0);
-    offsets[i] = current_offset;
-    current_offset += recv_counts[i];
+    output[static_cast<std::size_t>(current_row)] = row_min;
   }
 
-  MPI_Allgatherv(local_results.data(), my_count, MPI_INT, GetOutput().data(), recv_counts.data(), offsets.data(),
-                 MPI_INT, MPI_COMM_WORLD);
+  ppc::mpi::AllgatherInPlace(std::span<int>(output), distribution);
 
   return true;
 }
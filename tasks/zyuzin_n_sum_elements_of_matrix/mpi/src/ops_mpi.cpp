@@ -4,8 +4,11 @@
 
 #include <cstddef>
 #include <numeric>
+#include <span>
 #include <vector>
 
+#include "mpi/include/distribution.hpp"
+#include "mpi/include/pipeline.hpp"
 #include "zyuzin_n_sum_elements_of_matrix/common/include/common.hpp"
 
 namespace zyuzin_n_sum_elements_of_matrix {
@@ -29,36 +32,16 @@ bool ZyuzinNSumElementsOfMatrixMPI::PreProcessingImpl() {
 
 bool ZyuzinNSumElementsOfMatrixMPI::RunImpl() {
   const auto &matrix = GetInput();
-  int rank = 0;
   int size = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  int rows_per_proc = std::get<0>(matrix) / size;
-  int ost = std::get<0>(matrix) % size;
-
-  std::vector<int> send_counts(size, 0);
-  std::vector<int> start_indexs(size, 0);
-  int offset = 0;
-  for (int i = 0; i < size; ++i) {
-    int rows = rows_per_proc + (ost > 0 ? 1 : 0);
-    if (ost > 0) {
-      --ost;
-    }
-    send_counts[i] = rows * std::get<1>(matrix);
-    start_indexs[i] = offset;
-    offset += send_counts[i];
-  }
-
-  std::vector<double> local_data(send_counts[rank]);
-  MPI_Scatterv(std::get<2>(matrix).data(), send_counts.data(), start_indexs.data(), MPI_DOUBLE, local_data.data(),
-               send_counts[rank], MPI_DOUBLE, 0, MPI_COMM_WORLD);
-
-  double local_sum = std::accumulate(local_data.begin(), local_data.end(), 0.0);
-  double global_sum = 0.0;
-  MPI_Allreduce(&local_sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-
-  GetOutput() = global_sum;
+  const auto distribution = ppc::mpi::BlockDistribution(static_cast<std::size_t>(std::get<0>(matrix)), size,
+                                                        static_cast<std::size_t>(std::get<1>(matrix)));
+  const auto chunk_sum = [](double acc, std::span<const double> chunk) {
+    return std::accumulate(chunk.begin(), chunk.end(), acc);
+  };
+  GetOutput() = ppc::mpi::PipelinedScatterReduce(std::span<const double>(std::get<2>(matrix)), distribution, 0.0,
+                                                 chunk_sum, MPI_SUM);
   return true;
 }
 